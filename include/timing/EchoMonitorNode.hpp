@@ -19,6 +19,7 @@
 #include "uhal/DerivedNode.hpp"
 
 #include <string>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
@@ -44,6 +45,16 @@ public:
    * @brief     Get status string, optionally print.
    */
   std::string get_status(bool print_out = false) const override;
+
+protected:
+  enum Register
+  {
+    kCtrlGo,
+    kStatRxDone,
+    kStatDeltat,
+  };
+  static const std::vector<std::string> kRegisterPaths;
+  NodeHandleTable m_registers;
 };
 
 } // namespace timing
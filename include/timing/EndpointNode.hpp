@@ -93,6 +93,11 @@ public:
    */
   void get_info(opmonlib::InfoCollector& ci, int level) const override;
 
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
+
   /**
    * @brief    Get the states map
    */
@@ -115,6 +120,9 @@ protected:
     { 0xe, "Time check error (0xe)" },                     // 0b1110 when ST_ERR_T, -- Time check error
     { 0xf, "Protocol error (0xf)" },                       // 0b1111 when ST_ERR_X; -- Protocol error
   };
+
+private:
+  std::function<void(timingendpointinfo::TimingEndpointInfo&)> queue_monitor_data() const;
 };
 
 } // namespace timing
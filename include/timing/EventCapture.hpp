@@ -0,0 +1,201 @@
+/**
+ * @file EventCapture.hpp
+ *
+ * EventCaptureWriter and EventCaptureReader record and replay
+ * HSI and partition event streams in memory mapped binary files.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_EVENTCAPTURE_HPP_
+#define TIMING_INCLUDE_TIMING_EVENTCAPTURE_HPP_
+
+#include "ers/Issue.hpp"
+
+// C++ Headers
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dunedaq {
+ERS_DECLARE_ISSUE(timing,                                        ///< Namespace
+                  EventCaptureError,                             ///< Issue class name
+                  "Event capture file " << path << ": " << message, ///< Message
+                  ((std::string)path)((std::string)message)      ///< Message parameters
+)
+namespace timing {
+
+/**
+ * @brief      Capture file header, the first page of the file.
+ */
+struct EventCaptureHeader
+{
+  char magic[8];
+  uint32_t version;            // NOLINT(build/unsigned)
+  uint32_t stream_type;        // NOLINT(build/unsigned)
+  uint32_t words_per_event;    // NOLINT(build/unsigned)
+  uint32_t records_per_chunk;  // NOLINT(build/unsigned)
+  uint64_t board_uid;          // NOLINT(build/unsigned)
+  uint32_t firmware_version;   // NOLINT(build/unsigned)
+  uint32_t clock_frequency_hz; // NOLINT(build/unsigned)
+  int64_t start_time_ns;       // host system clock, since the epoch
+  uint64_t record_count;       // NOLINT(build/unsigned) kept up to date while writing
+};
+
+/**
+ * @brief      One event: its timestamp and raw words, zero padded.
+ */
+struct EventCaptureRecord
+{
+  uint64_t timestamp; // NOLINT(build/unsigned)
+  uint32_t words[6];  // NOLINT(build/unsigned)
+};
+
+/**
+ * @brief      Index entry closing every chunk of records.
+ */
+struct EventCaptureIndexEntry
+{
+  uint64_t first_timestamp; // NOLINT(build/unsigned)
+  uint64_t last_timestamp;  // NOLINT(build/unsigned)
+  uint64_t first_record;    // NOLINT(build/unsigned)
+  uint32_t n_records;       // NOLINT(build/unsigned)
+  uint32_t magic;           // NOLINT(build/unsigned)
+};
+
+/**
+ * @brief      Capture file layout.
+ *
+ *             A header page, then chunks of kRecordsPerChunk - 1 fixed size records, each closed by an
+ *             index entry in the last record slot. Chunks are page aligned, so that the file maps in whole
+ *             chunks. Records are in host byte order.
+ */
+class EventCapture
+{
+public:
+  enum StreamType
+  {
+    kHSIStream = 0,
+    kPartitionStream = 1,
+  };
+
+  //! Record slots per chunk, the last one holding the index entry
+  static const size_t kRecordsPerChunk;
+
+  //! Size of the header page
+  static const size_t kHeaderSize;
+
+  static const char kMagic[8];
+  static const uint32_t kVersion;    // NOLINT(build/unsigned)
+  static const uint32_t kIndexMagic; // NOLINT(build/unsigned)
+
+  static size_t chunk_size() { return kRecordsPerChunk * sizeof(EventCaptureRecord); }
+  static size_t words_per_event(StreamType type);
+
+  /**
+   * @brief      Timestamp of a raw event.
+   */
+  static uint64_t event_timestamp(StreamType type, const uint32_t* words); // NOLINT(build/unsigned)
+
+  /**
+   * @brief      File offset of a record.
+   */
+  static size_t record_offset(uint64_t record); // NOLINT(build/unsigned)
+};
+
+/**
+ * @brief      Append-only capture writer.
+ *
+ *             The file grows in extents of kChunksPerExtent chunks, each mapped once, so that events
+ *             are appended with plain memory copies; the only system calls are per extent. The record
+ *             count in the header is updated on every append, so that the file stays readable, up to the
+ *             last append, if the writer does not close it.
+ *
+ *             Feed it from the readout, e.g. HSIReadoutEngine::set_capture_writer.
+ */
+class EventCaptureWriter
+{
+public:
+  EventCaptureWriter(const std::string& path,
+                     EventCapture::StreamType type,
+                     uint64_t board_uid,          // NOLINT(build/unsigned)
+                     uint32_t firmware_version,   // NOLINT(build/unsigned)
+                     uint32_t clock_frequency_hz); // NOLINT(build/unsigned)
+  EventCaptureWriter(const EventCaptureWriter&) = delete;
+  EventCaptureWriter& operator=(const EventCaptureWriter&) = delete;
+  ~EventCaptureWriter();
+
+  /**
+   * @brief      Append n_events raw events, EventCapture::words_per_event words each.
+   */
+  void append(const uint32_t* words, size_t n_events); // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Close the last chunk and truncate the file to the records written.
+   */
+  void close();
+
+  uint64_t get_record_count() const { return m_record_count; } // NOLINT(build/unsigned)
+  EventCapture::StreamType get_stream_type() const { return m_type; }
+  const std::string& get_path() const { return m_path; }
+
+  //! Chunks mapped at once
+  static const size_t kChunksPerExtent;
+
+private:
+  void map_extent(size_t offset);
+  void unmap_extent();
+  void write_index_entry(uint64_t record); // NOLINT(build/unsigned)
+
+  const std::string m_path;
+  const EventCapture::StreamType m_type;
+  int m_fd;
+
+  EventCaptureHeader* m_header;
+  char* m_extent;
+  size_t m_extent_offset;
+
+  uint64_t m_record_count; // NOLINT(build/unsigned)
+  uint64_t m_chunk_first_timestamp; // NOLINT(build/unsigned)
+};
+
+/**
+ * @brief      Capture reader, mapping the whole file.
+ */
+class EventCaptureReader
+{
+public:
+  explicit EventCaptureReader(const std::string& path);
+  EventCaptureReader(const EventCaptureReader&) = delete;
+  EventCaptureReader& operator=(const EventCaptureReader&) = delete;
+  ~EventCaptureReader();
+
+  const EventCaptureHeader& get_header() const { return *m_header; }
+  EventCapture::StreamType get_stream_type() const { return static_cast<EventCapture::StreamType>(m_header->stream_type); }
+
+  uint64_t size() const { return m_record_count; } // NOLINT(build/unsigned)
+
+  const EventCaptureRecord& at(uint64_t record) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      First record with a timestamp not before the given one, size() if none.
+   *
+   *             Binary search over the chunk index entries, then within the chunk. Assumes the
+   *             timestamps do not decrease along the file.
+   */
+  uint64_t seek(uint64_t timestamp) const; // NOLINT(build/unsigned)
+
+private:
+  const std::string m_path;
+  const char* m_data;
+  size_t m_size;
+  const EventCaptureHeader* m_header;
+  uint64_t m_record_count; // NOLINT(build/unsigned)
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_EVENTCAPTURE_HPP_
@@ -0,0 +1,108 @@
+/**
+ * @file EventDecoder.hpp
+ *
+ * EventDecoder unpacks raw HSI and partition readout buffers
+ * into columnar event arrays.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_EVENTDECODER_HPP_
+#define TIMING_INCLUDE_TIMING_EVENTDECODER_HPP_
+
+// C++ Headers
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+/**
+ * @brief      HSI events, one array per field.
+ *
+ *             Event words: header, timestamp low, timestamp high, signal map, sequence.
+ */
+struct HSIEvents
+{
+  std::vector<uint32_t> header;     // NOLINT(build/unsigned)
+  std::vector<uint64_t> timestamp;  // NOLINT(build/unsigned)
+  std::vector<uint32_t> signal_map; // NOLINT(build/unsigned)
+  std::vector<uint32_t> sequence;   // NOLINT(build/unsigned)
+
+  size_t size() const { return timestamp.size(); }
+  void reserve(size_t n_events);
+  void clear();
+};
+
+/**
+ * @brief      Partition events, one array per field.
+ *
+ *             Event words: header, command, timestamp low, timestamp high, event counter, checksum.
+ */
+struct PartitionEvents
+{
+  std::vector<uint32_t> header;        // NOLINT(build/unsigned)
+  std::vector<uint32_t> command;       // NOLINT(build/unsigned)
+  std::vector<uint64_t> timestamp;     // NOLINT(build/unsigned)
+  std::vector<uint32_t> event_counter; // NOLINT(build/unsigned)
+
+  size_t size() const { return timestamp.size(); }
+  void reserve(size_t n_events);
+  void clear();
+};
+
+/**
+ * @brief      Outcome of decoding a buffer.
+ */
+struct EventDecodeResult
+{
+  size_t n_events;       // events appended
+  size_t bad_headers;    // events whose first word is not kEventHeader
+  size_t sequence_gaps;  // events not following the previous one in sequence (including the last event already held)
+  size_t trailing_words; // words of an incomplete last event, not decoded
+};
+
+/**
+ * @brief      Decoders from raw readout words to columnar arrays.
+ *
+ *             Events are appended to the arrays, so that a stream can be decoded buffer by buffer
+ *             with the sequence check carried over. The field extraction and the header and sequence
+ *             checks run in a single branch free loop over the events, which the compiler can vectorise;
+ *             checks only count problems, callers decide what to do with them.
+ *
+ *             The container overloads take any contiguous container, e.g. std::vector or uhal::ValVector.
+ */
+class EventDecoder
+{
+public:
+  static EventDecodeResult decode_hsi_events(const uint32_t* words, // NOLINT(build/unsigned)
+                                             size_t n_words,
+                                             HSIEvents& events);
+
+  template<typename T>
+  static EventDecodeResult decode_hsi_events(const T& words, HSIEvents& events)
+  {
+    return decode_hsi_events(words.size() ? &*words.begin() : nullptr, words.size(), events);
+  }
+
+  static EventDecodeResult decode_partition_events(const uint32_t* words, // NOLINT(build/unsigned)
+                                                   size_t n_words,
+                                                   PartitionEvents& events);
+
+  template<typename T>
+  static EventDecodeResult decode_partition_events(const T& words, PartitionEvents& events)
+  {
+    return decode_partition_events(words.size() ? &*words.begin() : nullptr, words.size(), events);
+  }
+
+  //! First word of every HSI and partition event
+  static const uint32_t kEventHeader; // NOLINT(build/unsigned)
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_EVENTDECODER_HPP_
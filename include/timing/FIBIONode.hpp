@@ -51,12 +51,12 @@ public:
     /**
      * @brief      Reset FIB node.
      */
-    void reset(int32_t fanout_mode, const std::string& clock_config_file="") const override;
+    void reset(int32_t fanout_mode, const std::string& clock_config_file="", bool warm_restart=false) const override;
 
     /**
      * @brief      Reset FIB node.
      */
-    void reset(const std::string& clock_config_file="") const override;
+    void reset(const std::string& clock_config_file="", bool warm_restart=false) const override;
 
     /**
      * @brief     Switch the SFP mux channel
@@ -133,8 +133,15 @@ public:
      */
     void get_info(opmonlib::InfoCollector& ci, int level) const override;
 
+    /**
+     * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+     */
+    InfoDecoder queue_info(int level) const override;
+
 private:
 
+    std::function<void(timinghardwareinfo::TimingFIBMonitorData&)> queue_monitor_data() const;
+    InfoDecoder sample_i2c_info(int level) const override;
     void validate_sfp_id(uint32_t sfp_id) const; // NOLINT(build/unsigned)
 
 };
@@ -24,10 +24,23 @@
 #include <nlohmann/json.hpp>
 
 #include <string>
+#include <utility>
 
 namespace dunedaq {
 namespace timing {
 
+/**
+ * @brief      Outcome of a burst of fixed length commands.
+ */
+struct FLCmdBurstResult
+{
+  uint32_t sent;     // NOLINT(build/unsigned)
+  uint32_t accepted; // NOLINT(build/unsigned)
+  uint32_t rejected; // NOLINT(build/unsigned)
+  uint32_t dropped;  // NOLINT(build/unsigned) sent, but counted neither as accepted nor as rejected
+  double rate_hz;    // achieved injection rate
+};
+
 /**
  * @brief      Class for master global node.
  */
@@ -48,6 +61,24 @@ public:
    */
   virtual void send_fl_cmd(uint32_t command,        // NOLINT(build/unsigned)
                            uint32_t channel) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief     Select the command and channel of the next force pulses. Queued only, unless dispatch is set.
+   */
+  void select_fl_cmd(uint32_t command,          // NOLINT(build/unsigned)
+                     uint32_t channel,          // NOLINT(build/unsigned)
+                     bool dispatch = true) const;
+
+  /**
+   * @brief     Queue force pulses for the selected command, without dispatching.
+   */
+  void queue_fl_cmd_pulses(uint32_t number_of_commands) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief     Read the accepted and rejected command counters, one entry per channel.
+   */
+  std::pair<uhal::ValVector<uint32_t>, uhal::ValVector<uint32_t>> // NOLINT(build/unsigned)
+  read_counters(bool dispatch = true) const;
   /**
    * @brief     Configure fake trigger
    */
@@ -97,6 +128,11 @@ public:
    */
   void get_info(opmonlib::InfoCollector& ic, int level) const override;
 
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
+
   static void parse_periodic_fl_cmd_rate(double requested_rate, uint32_t clock_frequency_hz, double& actual_rate, uint32_t& divisor, uint32_t& prescale);
 private:
   void validate_command(uint32_t command) const;
@@ -54,13 +54,13 @@ public:
   /**
    * @brief      Reset FMC IO.
    */
-  void reset(const std::string& clock_config_file = "") const override;
+  void reset(const std::string& clock_config_file = "", bool warm_restart = false) const override;
 
   /**
    * @brief     Reset FMC IO.
    */
   void reset(int32_t fanout_mode = -1, // NOLINT(build/unsigned)
-                     const std::string& clock_config_file = "") const override;
+                     const std::string& clock_config_file = "", bool warm_restart = false) const override;
   
   /**
     * @brief      Read frequencies of on-board clocks.
@@ -81,6 +81,15 @@ public:
    * @brief    Give info to collector.
    */
   void get_info(opmonlib::InfoCollector& ci, int level) const override;
+
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
+
+private:
+  std::function<void(timinghardwareinfo::TimingFMCMonitorData&)> queue_monitor_data() const;
+  InfoDecoder sample_i2c_info(int level) const override;
 };
 
 } // namespace timing
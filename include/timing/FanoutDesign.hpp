@@ -64,7 +64,9 @@ public:
   /**
    * @brief      Reset timing fanout node.
    */
-  void reset_io(int32_t fanout_mode, const std::string& clock_config_file = "") const override; // NOLINT(build/unsigned)
+  void reset_io(int32_t fanout_mode, // NOLINT(build/unsigned)
+                const std::string& clock_config_file = "",
+                bool warm_restart = false) const override;
 
   /**
    * @brief      Measure the endpoint round trip time.
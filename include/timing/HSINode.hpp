@@ -25,6 +25,7 @@
 
 // C++ Headers
 #include <chrono>
+#include <functional>
 #include <string>
 
 namespace dunedaq {
@@ -118,6 +119,12 @@ public:
    */
   uint32_t read_buffer_state() const; // NOLINT(build/unsigned)
 
+  /**
+   * @brief     Queue the buffer state reads, the returned function gives the state after dispatch
+   *
+   */
+  std::function<uint32_t()> queue_buffer_state() const; // NOLINT(build/unsigned)
+
   /**
    * @brief     Read signal source, 0 - hardware, 1 - internal emulation
    *
@@ -134,8 +141,17 @@ public:
    * @brief    Give info to collector.
    */
   void get_info(opmonlib::InfoCollector& ci, int level) const override;
+
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
   
   static inline constexpr size_t hsi_buffer_event_words_number = 5;
+  static inline constexpr size_t hsi_buffer_words_number = 1024;
+
+private:
+  std::function<void(timingfirmwareinfo::HSIFirmwareMonitorData&)> queue_monitor_data() const;
 };
 
 } // namespace timing
@@ -0,0 +1,154 @@
+/**
+ * @file HSIReadoutEngine.hpp
+ *
+ * HSIReadoutEngine continuously drains the HSI event buffer
+ * into a host side ring buffer.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_HSIREADOUTENGINE_HPP_
+#define TIMING_INCLUDE_TIMING_HSIREADOUTENGINE_HPP_
+
+#include "timing/EventCapture.hpp"
+#include "timing/HSINode.hpp"
+
+// C++ Headers
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+/**
+ * @brief      Streaming readout of the HSI event buffer.
+ *
+ *             A poller thread reads the buffer state, then drains the complete events into a
+ *             preallocated ring and reads the state left behind in the same dispatch, so that a
+ *             busy buffer costs two round trips per poll. The words that arrived between the state
+ *             left by one poll and the state read by the next give the event rate; the poll interval
+ *             follows it, aiming at kTargetOccupancy of the firmware buffer, and drops to the
+ *             minimum while the buffer warning or error flag is set.
+ *
+ *             The ring is single producer, single consumer and lock free. A consumer peeks at
+ *             the filled part of the ring, which comes as at most two contiguous spans of whole
+ *             events, and releases the events once done with them:
+ *
+ *               auto spans = engine.peek();
+ *               for (auto& span : spans)
+ *                 process(span.data, span.n_events);
+ *               engine.release(spans[0].n_events + spans[1].n_events);
+ *
+ *             When the ring is full, the events are left in the firmware buffer.
+ */
+class HSIReadoutEngine
+{
+public:
+  /**
+   * @brief      Contiguous run of events in the ring, n_events * HSINode::hsi_buffer_event_words_number words.
+   */
+  struct EventSpan
+  {
+    const uint32_t* data; // NOLINT(build/unsigned)
+    size_t n_events;
+  };
+
+  /**
+   * @param[in]  hsi_node      HSI node to read out, must outlive the engine
+   * @param[in]  capacity      Ring size in events, rounded up to a power of two
+   * @param[in]  min_interval  Shortest time between polls
+   * @param[in]  max_interval  Longest time between polls
+   */
+  explicit HSIReadoutEngine(const HSINode& hsi_node,
+                            size_t capacity = kDefaultCapacity,
+                            std::chrono::microseconds min_interval = std::chrono::microseconds(100),
+                            std::chrono::microseconds max_interval = std::chrono::milliseconds(10));
+  HSIReadoutEngine(const HSIReadoutEngine&) = delete;
+  HSIReadoutEngine& operator=(const HSIReadoutEngine&) = delete;
+  ~HSIReadoutEngine();
+
+  /**
+   * @brief      Record every event read into a capture file, nullptr to stop. Only while stopped.
+   */
+  void set_capture_writer(EventCaptureWriter* writer);
+
+  /**
+   * @brief      Start the poller thread.
+   */
+  void start();
+
+  /**
+   * @brief      Stop the poller thread. Events already in the ring stay available.
+   */
+  void stop();
+
+  bool is_running() const;
+
+  /**
+   * @brief      Events in the ring, without copying them. Only valid until the next release.
+   */
+  std::array<EventSpan, 2> peek() const;
+
+  /**
+   * @brief      Hand back the oldest n_events events of the ring to the poller.
+   */
+  void release(size_t n_events);
+
+  size_t get_capacity() const { return m_capacity; }
+
+  size_t get_available_events() const;
+
+  uint64_t get_event_count() const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Print the readout counters and the current poll interval.
+   */
+  std::string get_status(bool print_out = false) const;
+
+  //! Default ring size [events]
+  static const size_t kDefaultCapacity;
+
+  //! Firmware buffer occupancy the poll interval is tuned for
+  static const double kTargetOccupancy;
+
+private:
+  void run();
+  std::chrono::nanoseconds next_interval(uint32_t buffer_state, double words_per_ns) const; // NOLINT(build/unsigned)
+
+  const HSINode& m_hsi_node;
+  const size_t m_capacity;
+  const std::chrono::nanoseconds m_min_interval;
+  const std::chrono::nanoseconds m_max_interval;
+
+  EventCaptureWriter* m_capture_writer;
+
+  std::vector<uint32_t> m_ring; // NOLINT(build/unsigned)
+  // event indices, only ever increasing, written by the poller and the consumer respectively
+  alignas(64) std::atomic<uint64_t> m_write_index; // NOLINT(build/unsigned)
+  alignas(64) std::atomic<uint64_t> m_read_index;  // NOLINT(build/unsigned)
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_stop_condition;
+  bool m_stop;
+  std::thread m_thread;
+
+  std::atomic<uint64_t> m_poll_count;       // NOLINT(build/unsigned)
+  std::atomic<uint64_t> m_ring_full_count;  // NOLINT(build/unsigned)
+  std::atomic<uint64_t> m_buffer_warnings;  // NOLINT(build/unsigned)
+  std::atomic<uint64_t> m_buffer_errors;    // NOLINT(build/unsigned)
+  std::atomic<int64_t> m_interval_ns;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_HSIREADOUTENGINE_HPP_
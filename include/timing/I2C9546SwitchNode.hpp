@@ -16,7 +16,9 @@
 #include "timing/I2CSlave.hpp"
 
 #include <map>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace dunedaq {
@@ -28,6 +30,11 @@ namespace timing {
  * @class      I2C9546SwitchSlave
  *
  * @brief      I2C slave class to control SFP expander chips.
+ *
+ *             The channel states last written or read are cached per I2C core
+ *             (I2CMasterNode::get_device_id) and device address, so that
+ *             redundant channel selections can be skipped across slave objects.
+ *             The states of a core are dropped when its master node is destroyed.
  * @author     Alessandro Thea
  * @date       April 2018
  */
@@ -65,9 +72,55 @@ public:
    */
   void set_channels_states(uint8_t channels) const; // NOLINT(build/unsigned)
 
+  /**
+   * @brief      Set channel states, unless they are already known to be set.
+   *
+   * @param[in]  channels  Enabled channels byte
+   * @param[in]  force     Write the channel states regardless of the cache
+   *
+   * @return     True if the channel states were written
+   */
+  bool select_channels(uint8_t channels, bool force = false) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Cached channel states.
+   *
+   * @param[out] channels  Enabled channels byte
+   *
+   * @return     False if the channel states are unknown
+   */
+  bool get_cached_channels_states(uint8_t& channels) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Order a sweep over single channels so that it starts from the selected one.
+   *
+   * @param[in]  channels  Channel identifiers to sweep over
+   *
+   * @return     The rotated channel identifiers
+   */
+  std::vector<uint8_t> order_sweep(const std::vector<uint8_t>& channels) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Forget the cached channel states, e.g. after the switch has been reset.
+   */
+  void invalidate_channels_states() const;
+
+  /**
+   * @brief      Drop the cached channel states of every switch behind an I2C core.
+   */
+  static void drop_device_channels_states(const std::string& device_id);
+
 private:
   void ensure_valid_channel(uint8_t channel) const; // NOLINT(build/unsigned)
 
+  void update_cache(uint8_t channels) const; // NOLINT(build/unsigned)
+
+  typedef std::pair<std::string, uint8_t> CacheKey_t; // NOLINT(build/unsigned)
+
+  CacheKey_t m_cache_key;
+
+  static std::map<CacheKey_t, uint8_t> s_channels_states; // NOLINT(build/unsigned)
+  static std::mutex s_channels_states_mutex;
 };
 
 } // namespace timing
@@ -16,7 +16,9 @@
 #include "timing/I2CSlave.hpp"
 
 #include <map>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace dunedaq {
@@ -28,12 +30,28 @@ namespace timing {
  * @class      I2CExpanderSlave
  *
  * @brief      I2C slave class to control SFP expander chips.
+ *
+ *             Shadow copies of the output, inversion and io registers are kept
+ *             per I2C core (I2CMasterNode::get_device_id) and device address, so
+ *             that they survive the slave objects, which are created on every
+ *             access. Single bit updates are then write-only. The copies of a
+ *             core are dropped when its master node is destroyed.
  * @author     Alessandro Thea
  * @date       April 2018
  */
 class I2CExpanderSlave : public I2CSlave
 {
 public:
+  /**
+   * @brief      Configuration of one bank
+   */
+  struct BankConfig
+  {
+    uint8_t inversion; // NOLINT(build/unsigned)
+    uint8_t io;        // NOLINT(build/unsigned)
+    uint8_t outputs;   // NOLINT(build/unsigned)
+  };
+
   I2CExpanderSlave(const I2CMasterNode* i2c_master, uint8_t i2c_device_address); // NOLINT(build/unsigned)
   virtual ~I2CExpanderSlave();
 
@@ -79,10 +97,71 @@ public:
    */
   uint8_t read_outputs_config( uint8_t bank_id ) const; // NOLINT(build/unsigned)
 
+  /**
+   * @brief      Configure both banks, one burst write per register pair.
+   *
+   * @param[in]  bank_0  Bank 0 configuration
+   * @param[in]  bank_1  Bank 1 configuration
+   */
+  void configure(const BankConfig& bank_0, const BankConfig& bank_1) const;
+
+  /**
+   * @brief      Set a single output bit from the shadow output register, without reading it back.
+   *
+   * @param[in]  bank_id  A bank identifier
+   * @param[in]  bit      The bit to set
+   * @param[in]  value    The bit value
+   * @param[in]  resync   Re-read the output register before the update
+   */
+  void set_output_bit(uint8_t bank_id, uint8_t bit, bool value, bool resync = false) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Re-read the output, inversion and io registers into the shadow copy.
+   */
+  void resync() const;
+
+  /**
+   * @brief      Drop the shadow copy, e.g. after the expander has been reset.
+   */
+  void invalidate_shadow() const;
+
+  /**
+   * @brief      Drop the shadow copies of every expander behind an I2C core.
+   */
+  static void drop_device_shadows(const std::string& device_id);
+
   std::vector<uint32_t> debug() const; // NOLINT(build/unsigned)
 
 private:
   void ensure_valid_bank_id(uint8_t bank_id) const; // NOLINT(build/unsigned)
+
+  void write_register(uint8_t address, uint8_t value) const;                      // NOLINT(build/unsigned)
+  void write_register_pair(uint8_t address, uint8_t value_0, uint8_t value_1) const; // NOLINT(build/unsigned)
+  uint8_t read_register(uint8_t address) const;                                   // NOLINT(build/unsigned)
+
+  void update_shadow(uint8_t address, uint8_t value) const; // NOLINT(build/unsigned)
+  void invalidate_shadow(uint8_t address) const;            // NOLINT(build/unsigned)
+  bool get_shadow(uint8_t address, uint8_t& value) const;   // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Shadow copy of the expander registers, indexed by register address
+   */
+  struct ShadowRegisters
+  {
+    uint8_t values[8] = {}; // NOLINT(build/unsigned)
+    bool valid[8] = {};
+  };
+
+  typedef std::pair<std::string, uint8_t> ShadowKey_t; // NOLINT(build/unsigned)
+
+  ShadowKey_t m_shadow_key;
+
+  static std::map<ShadowKey_t, ShadowRegisters> s_shadows;
+  static std::mutex s_shadows_mutex;
+
+  static const uint8_t kOutputsRegister;   // NOLINT(build/unsigned)
+  static const uint8_t kInversionRegister; // NOLINT(build/unsigned)
+  static const uint8_t kIORegister;        // NOLINT(build/unsigned)
 };
 
 } // namespace timing
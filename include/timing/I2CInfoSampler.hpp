@@ -0,0 +1,86 @@
+/**
+ * @file I2CInfoSampler.hpp
+ *
+ * I2CInfoSampler refreshes the slow, I2C derived, monitoring
+ * data of a timing board in a background thread.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_I2CINFOSAMPLER_HPP_
+#define TIMING_INCLUDE_TIMING_I2CINFOSAMPLER_HPP_
+
+#include "timing/TimingNode.hpp"
+
+#include "timing/timinghardwareinfo/InfoNljs.hpp"
+#include "timing/timinghardwareinfo/InfoStructs.hpp"
+
+#include "opmonlib/InfoCollector.hpp"
+
+// C++ Headers
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace dunedaq {
+namespace timing {
+
+/**
+ * @brief      Background sampler of I2C monitoring data.
+ *
+ *             The sample function reads the devices and returns a decoder replaying
+ *             the values into a collector; the latest one is kept and handed out by get_info.
+ *             Copies are stopped and empty, so that the IO nodes holding a sampler can be
+ *             cloned by uhal.
+ */
+class I2CInfoSampler
+{
+public:
+  typedef std::function<TimingNode::InfoDecoder()> SampleFunction;
+
+  I2CInfoSampler();
+  I2CInfoSampler(const I2CInfoSampler& other);
+  I2CInfoSampler& operator=(const I2CInfoSampler&) = delete;
+  ~I2CInfoSampler();
+
+  /**
+   * @brief      Start sampling every period, restarting the sampler if already running.
+   */
+  void start(SampleFunction sample, std::chrono::milliseconds period);
+
+  /**
+   * @brief      Stop sampling, waiting for a sample in progress. The last sample is kept.
+   */
+  void stop();
+
+  bool is_running() const;
+
+  /**
+   * @brief      Replay the latest sample into the collector, with its age.
+   *
+   * @return     false if no sample has been taken yet.
+   */
+  bool get_info(opmonlib::InfoCollector& ci) const;
+
+private:
+  void run(SampleFunction sample, std::chrono::milliseconds period);
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_stop_condition;
+  bool m_stop;
+  std::thread m_thread;
+
+  TimingNode::InfoDecoder m_sample;
+  std::chrono::steady_clock::time_point m_sample_time;
+  uint64_t m_sample_count;        // NOLINT(build/unsigned)
+  uint64_t m_failed_sample_count; // NOLINT(build/unsigned)
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_I2CINFOSAMPLER_HPP_
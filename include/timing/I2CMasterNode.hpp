@@ -28,6 +28,9 @@
 #include "ers/Issue.hpp"
 #include "uhal/DerivedNode.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -52,8 +55,23 @@ public:
   virtual uint8_t get_slave_address(const std::string& name) const; // NOLINT(build/unsigned)
   virtual const I2CSlave& get_slave(const std::string& name) const;
 
+  /**
+   * @brief      Reset the I2C core, reprogramming the clock prescale if it does not match.
+   */
   void reset() const;
 
+  /**
+   * @brief      Forget that the I2C core has been initialised, e.g. after a firmware or I2C core reset.
+   *             The next transaction calls reset() first.
+   */
+  void invalidate_core_state() const;
+
+  /**
+   * @brief      Identifier of the I2C core on the hardware, client URI and node path. Keys the device
+   *             caches that outlive the slave objects, whose entries are dropped with this node.
+   */
+  const std::string& get_device_id() const;
+
   /// commodity functions
   virtual uint8_t read_i2c(uint8_t i2c_device_address, uint32_t i2c_reg_address) const; // NOLINT(build/unsigned)
   virtual void write_i2c(uint8_t i2c_device_address,                                    // NOLINT(build/unsigned)
@@ -97,8 +115,44 @@ private:
   ///
   void constructor();
 
+  /**
+   * @brief      Reset the I2C core unless it is known to be initialised already.
+   */
+  void ensure_core_initialised() const;
+
   // low level i2c functions
-  void wait_until_finished(bool require_acknowledgement = true, bool require_bus_idle_at_end = false) const;
+  /**
+   * @brief      Wait for the transfer issued at issue_time to complete and check its status. Throws on errors.
+   *             The first status read is issued one byte time after issue_time, the timeout is a number of byte times.
+   *
+   * @return     The content of the rx register, read in the same dispatch as the final status
+   */
+  uint8_t wait_until_finished(const std::chrono::steady_clock::time_point& issue_time, // NOLINT(build/unsigned)
+                              bool require_acknowledgement = true,
+                              bool require_bus_idle_at_end = false) const;
+
+  /**
+   * @brief      Minimum time needed by the core to clock one byte (and its acknowledge) on the bus.
+   */
+  std::chrono::nanoseconds get_byte_transfer_time() const;
+
+  /**
+   * @brief      Sleep until the byte transfer started at issue_time is expected to be complete.
+   */
+  void wait_for_byte_transfer(const std::chrono::steady_clock::time_point& issue_time) const;
+
+  /**
+   * @brief      Stop a failed block transfer: wait for the byte issued at issue_time, send a stop and
+   *             invalidate the core state. Does not throw.
+   */
+  void abort_transfer(const std::chrono::steady_clock::time_point& issue_time) const;
+
+  /**
+   * @brief      Check a status word read back after a byte transfer. Throws on errors.
+   */
+  void check_transfer_status(uint32_t i2c_status,            // NOLINT(build/unsigned)
+                             bool require_acknowledgement,
+                             bool require_bus_idle_at_end) const;
 
   //! IPBus register names for i2c bus
   static const std::string kPreHiNode;
@@ -122,9 +176,22 @@ private:
   static const uint8_t kInProgressBit;      // inprogress = 0x1 << 1 // NOLINT(build/unsigned)
   static const uint8_t kInterruptBit;       // interrupt = 0x1       // NOLINT(build/unsigned)
 
+  static const double kCoreClockFrequency;    // I2C core input clock [Hz]
+  static const uint32_t kClocksPerByte;       // SCL periods per byte, including ack and start/stop // NOLINT(build/unsigned)
+  static const double kByteTransferTimeMargin; // safety factor applied to the nominal byte time
+  static const uint32_t kCompletionTimeoutBytes; // transfer timeout, in byte times // NOLINT(build/unsigned)
+  static const uint32_t kCompletionPollsPerByte; // status polls per byte time after the first one // NOLINT(build/unsigned)
+
   //! clock prescale factor
   uint16_t m_clock_prescale; // NOLINT(build/unsigned)
 
+  //! True once reset() has run, until the core state is invalidated. Atomic, as IO nodes may sample in the background
+  mutable std::atomic<bool> m_core_initialised;
+
+  //! Computed on first use, when the node is attached to its client
+  mutable std::string m_device_id;
+  mutable std::once_flag m_device_id_flag;
+
   //! I2C slaves attached to this node
   std::unordered_map<std::string, I2CSlave*>
     m_i2c_devices; // TODO, Eric Flumerfelt <eflumerf@fnal.gov> May-21-2021: Consider using smart pointers
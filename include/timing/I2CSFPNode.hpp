@@ -22,6 +22,8 @@
 #include "ers/Issue.hpp"
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -40,6 +42,40 @@ class I2CSFPSlave : public I2CSlave
 {
 
 public:
+  /**
+   * @brief      Static SFP content: identity (A0h) and DDM calibration constants (A2h).
+   */
+  struct StaticInfo
+  {
+    std::string vendor_name;
+    std::string vendor_pn;
+    std::string serial_number;
+    bool ddm_supported;
+    bool address_swap_required;
+    bool soft_tx_control_supported;
+    //! (slope, offset) for laser current, tx power, temperature and voltage
+    std::vector<std::pair<double, double>> calibration_pairs;
+    //! Rx power polynomial coefficients, 0th order first
+    std::vector<double> rx_power_parameters;
+  };
+
+  /**
+   * @brief      Decoded SFP state.
+   */
+  struct Snapshot
+  {
+    std::shared_ptr<const StaticInfo> static_info;
+    //! True if the DDM values below were read
+    bool ddm_valid;
+    double temperature;
+    double supply_voltage;
+    double rx_power;
+    double tx_power;
+    double laser_current;
+    bool tx_disable_sw;
+    bool tx_disable_hw;
+  };
+
   I2CSFPSlave(const I2CMasterNode* i2c_master, uint8_t i2c_device_address); // NOLINT(build/unsigned)
   virtual ~I2CSFPSlave();
 
@@ -177,6 +213,22 @@ public:
    */
   void switch_soft_tx_control_bit(bool turn_on) const;
 
+  /**
+   * @brief      Read the static SFP content. The content is read once per SFP (vendor, part and serial number) and cached.
+   */
+  std::shared_ptr<const StaticInfo> read_static_info() const;
+
+  /**
+   * @brief      Read and decode the SFP state: the vendor, part and serial numbers and the A2h
+   *             diagnostics block in two burst reads, the rest from the static content cache.
+   */
+  Snapshot read_snapshot() const;
+
+  /**
+   * @brief      Drop all cached static SFP content.
+   */
+  static void clear_static_info_cache();
+
   /**
    * @brief      Get SFP status
    */
@@ -194,6 +246,18 @@ public:
 
 protected:
   const std::vector<uint32_t> m_calibration_parameter_start_addresses; // NOLINT(build/unsigned)
+
+private:
+  static std::pair<double, double> decode_calibration_parameter_pair(const std::vector<uint8_t>& data, // NOLINT(build/unsigned)
+                                                                     size_t offset);
+  static double decode_temperature_raw(const std::vector<uint8_t>& data, size_t offset); // NOLINT(build/unsigned)
+  static double decode_word(const std::vector<uint8_t>& data, size_t offset);            // NOLINT(build/unsigned)
+  static double decode_float(const std::vector<uint8_t>& data, size_t offset);           // NOLINT(build/unsigned)
+  static double calibrate_rx_power(double rx_power_raw, const std::vector<double>& parameters);
+
+  //! Static SFP content, keyed by vendor name, part number and serial number
+  static std::map<std::string, std::shared_ptr<const StaticInfo>> s_static_info_cache;
+  static std::mutex s_static_info_cache_mutex;
 };
 
 /**
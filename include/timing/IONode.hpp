@@ -20,6 +20,7 @@
 #include "timing/DACNode.hpp"
 #include "timing/FrequencyCounterNode.hpp"
 #include "timing/I2CExpanderNode.hpp"
+#include "timing/I2CInfoSampler.hpp"
 #include "timing/I2CMasterNode.hpp"
 #include "timing/I2CSFPNode.hpp"
 #include "timing/I2CSlave.hpp"
@@ -31,6 +32,7 @@
 // C++ Headers
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -130,8 +132,12 @@ public:
 
   /**
    * @brief      Configure clock chip.
+   *
+   * @param[in]  clock_config_file  The clock configuration file
+   * @param[in]  warm_restart       Only write the registers that differ from the chip content,
+   *                                skip the upload if the chip already runs the design and is locked.
    */
-  virtual void configure_pll(const std::string& clock_config_file = "") const;
+  virtual void configure_pll(const std::string& clock_config_file = "", bool warm_restart = false) const;
 
   /**
    * @brief      Read frequencies of on-board clocks.
@@ -158,6 +164,18 @@ public:
    */
   virtual void switch_sfp_soft_tx_control_bit(uint32_t sfp_id, bool turn_on) const; // NOLINT(build/unsigned)
 
+  /**
+   * @brief      Read the level 2 (I2C) monitoring data in a background thread, once per period.
+   *             Level 2 get_info then reports the latest sample and its age instead of reading the devices.
+   *             Samples hold the board I2C lock, the node methods using the I2C buses wait for them.
+   */
+  void start_i2c_info_sampler(std::chrono::milliseconds period) const;
+
+  /**
+   * @brief      Stop the background I2C sampling, level 2 get_info reads the devices again.
+   */
+  void stop_i2c_info_sampler() const;
+
   /**
    * @brief      Reset timing node.
    */
@@ -165,14 +183,18 @@ public:
 
   /**
    * @brief      Reset timing node.
+   *
+   * @param[in]  clock_config_file  The clock configuration file
+   * @param[in]  warm_restart       Keep the PLL running and only upload the registers that differ, see configure_pll
    */
-  virtual void reset(const std::string& clock_config_file = "") const = 0;
+  virtual void reset(const std::string& clock_config_file = "", bool warm_restart = false) const = 0;
 
   /**
    * @brief     Reset fanout board
    */
   virtual void reset(int32_t fanout_mode, // NOLINT(build/unsigned)
-                     const std::string& clock_config_file = "") const = 0;
+                     const std::string& clock_config_file = "",
+                     bool warm_restart = false) const = 0;
 
   static const std::map<BoardType, std::string>& get_board_type_map() { return board_type_map; }
 
@@ -197,6 +219,44 @@ protected:
    */
   virtual void write_soft_reset_register() const;
 
+  /**
+   * @brief      Mark the I2C cores of the board buses as uninitialised, after a reset of the firmware or of the cores.
+   */
+  void invalidate_i2c_core_states() const;
+
+  /**
+   * @brief      Read the level 2 monitoring data (PLL, SFPs) over I2C.
+   *
+   * @return     Decoder replaying the values read into a collector.
+   *
+   *             The sampler thread calls this, so nodes that override it stop the sampler in their destructor.
+   */
+  virtual InfoDecoder sample_i2c_info(int level) const;
+
+  /**
+   * @brief      Decoder for the level 2 monitoring data: the latest background sample
+   *             if the sampler is running, otherwise the devices are read at decode time.
+   */
+  InfoDecoder queue_i2c_info(int level) const;
+
+  /**
+   * @brief      Recursive mutex, fresh in copies so that the IO nodes can be cloned by uhal.
+   */
+  class I2CMutex : public std::recursive_mutex
+  {
+  public:
+    I2CMutex() = default;
+    I2CMutex(const I2CMutex& /*other*/)
+      : std::recursive_mutex()
+    {}
+  };
+
+  //! Serialises the I2C traffic of the board (mux selections and transactions) between
+  //! the background sampler and the node methods. Held for whole operations.
+  mutable I2CMutex m_i2c_mutex;
+
+  mutable I2CInfoSampler m_i2c_sampler;
+
   static inline const std::map<BoardType, std::string> board_type_map = { { kBoardFMC, "fmc" },
                                                             { kBoardSim, "sim" },
                                                             { kBoardPC059, "pc059" },
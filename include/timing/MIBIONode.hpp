@@ -24,6 +24,7 @@
 
 // C++ Headers
 #include <chrono>
+#include <memory>
 #include <string>
 
 namespace dunedaq {
@@ -53,25 +54,20 @@ public:
   std::string get_status(bool print_out = false) const override;
 
   /**
-   * @brief      Configure clock chip.
+   * @brief      Get the PLL chip, with the I2C switch set to the PLL channel.
    */
-  void configure_pll(const std::string& clock_config_file = "") const override;
-  
-  /**
-   * @brief      Print status of on-board PLL.
-   */
-  std::string get_pll_status(bool print_out = false) const override;
+  std::unique_ptr<const SI534xSlave> get_pll() const override;
 
   /**
    * @brief      Reset FMC IO.
    */
-  void reset(const std::string& clock_config_file = "") const override;
+  void reset(const std::string& clock_config_file = "", bool warm_restart = false) const override;
 
   /**
    * @brief     Reset FMC IO.
    */
   void reset(int32_t fanout_mode = -1, // NOLINT(build/unsigned)
-                     const std::string& clock_config_file = "") const override;
+                     const std::string& clock_config_file = "", bool warm_restart = false) const override;
   /**
    * @brief     Switch the SFP mux channel
    */
@@ -112,8 +108,16 @@ public:
    */
   void get_info(opmonlib::InfoCollector& ci, int level) const override;
 
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
+
 private:
+  std::function<void(timinghardwareinfo::TimingMIBMonitorData&)> queue_monitor_data() const;
+  InfoDecoder sample_i2c_info(int level) const override;
   void validate_sfp_id(uint32_t sfp_id) const; // NOLINT(build/unsigned)
+  void select_i2c_switch_channel(uint8_t channel) const; // NOLINT(build/unsigned)
   void validate_amc_slot(uint32_t amc_slot) const; // NOLINT(build/unsigned)
 };
 
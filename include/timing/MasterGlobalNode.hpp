@@ -19,6 +19,7 @@
 #include "uhal/DerivedNode.hpp"
 
 #include <string>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
@@ -38,6 +39,16 @@ public:
    */
   void enable_upstream_endpoint(uint32_t timeout = 500) const; // NOLINT(build/unsigned)
 
+  /**
+   * @brief     Pulse the upstream CDR and receiver resets.
+   */
+  void reset_upstream_receiver() const;
+
+  /**
+   * @brief     Wait for the upstream CDR and receiver to lock, without resetting them.
+   */
+  void wait_for_upstream_receiver(uint32_t timeout = 500) const; // NOLINT(build/unsigned)
+
   /**
    * @brief     Read the upstream endpoint ready reg.
    */
@@ -57,6 +68,19 @@ public:
    * @brief     Get status string, optionally print.
    */
   std::string get_status(bool print_out = false) const override;
+
+private:
+  enum Register
+  {
+    kCtrlResyncCdr,
+    kCtrlResync,
+    kCtrlClrCtrs,
+    kStatRxRdy,
+    kStatCdrLocked,
+    kStatCtrsRdy,
+  };
+  static const std::vector<std::string> kRegisterPaths;
+  NodeHandleTable m_registers;
 };
 
 } // namespace timing
@@ -27,6 +27,7 @@
 #include "uhal/DerivedNode.hpp"
 
 // C++ Headers
+#include <atomic>
 #include <chrono>
 #include <string>
 
@@ -41,6 +42,7 @@ class MasterNode : public MasterNodeInterface
   UHAL_DERIVEDNODE(MasterNode)
 public:
   explicit MasterNode(const uhal::Node& node);
+  MasterNode(const MasterNode& other);
   virtual ~MasterNode();
 
   /**
@@ -69,6 +71,17 @@ public:
   void send_fl_cmd(uint32_t command,                                // NOLINT(build/unsigned)
                    uint32_t channel,                                // NOLINT(build/unsigned)
                    uint32_t number_of_commands = 1) const override; // NOLINT(build/unsigned)
+
+  /**
+   * @brief     Send a burst of fixed length commands, queueing the force pulses of many commands per dispatch.
+   *            The command log is read back every log_sample_interval commands (never if 0), and the
+   *            generator counters give the number of accepted, rejected and dropped commands; dropped
+   *            commands are the ones counted neither as accepted nor as rejected.
+   */
+  FLCmdBurstResult send_fl_cmd_burst(uint32_t command,                    // NOLINT(build/unsigned)
+                                     uint32_t channel,                    // NOLINT(build/unsigned)
+                                     uint32_t number_of_commands,         // NOLINT(build/unsigned)
+                                     uint32_t log_sample_interval = 0) const; // NOLINT(build/unsigned)
   
   /**
    * @brief      Measure the endpoint round trip time.
@@ -92,7 +105,7 @@ public:
   /**
    * @brief     Set timestamp to current machine time
    */
-  void sync_timestamp(uint32_t clock_frequency_hz) const override; // NOLINT(build/unsigned)
+  TimestampSyncResult sync_timestamp(uint32_t clock_frequency_hz) const override; // NOLINT(build/unsigned)
 
     /**
    * @brief      Read the current timestamp word.
@@ -116,13 +129,22 @@ public:
    */
   void get_info(opmonlib::InfoCollector& ic, int level) const override;
 
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
+
   /**
    * @brief    Read some data from endpoint registers
    */
   void reset_command_counters() const;
 
   /**
-   * @brief    Send an async packet
+   * @brief    Send an async packet, and wait up to timeout [us] for the reply (none if negative)
+   *
+   *           Polling of the status flags starts after the reply latency learnt from the previous packets,
+   *           so that a command usually costs three round trips: the packet write, a single poll and the
+   *           reply read. The reply buffer is a port, so it is only read once the reply is complete.
    */
   std::vector<uint32_t> transmit_async_packet(const std::vector<uint32_t>& packet, int timeout=500) const;
 
@@ -151,6 +173,14 @@ public:
    */
   timingfirmware::EndpointCheckResult scan_endpoint(uint16_t endpoint_address, bool control_sfp) const override;
 
+  /**
+   * @brief    Scan a list of endpoints, pipelined: the delays are sent without waiting for the endpoints to
+   *           relock, and those endpoints are checked again once the others have been measured. A single
+   *           endpoint is checked again while still connected.
+   */
+  timingfirmware::EndpointCheckResultoVector scan_endpoints(const std::vector<uint16_t>& endpoint_addresses, // NOLINT(build/unsigned)
+                                                            bool control_sfp) const override;
+
   /**
    * @brief    Configure endpoint command decoder
    */
@@ -174,11 +204,49 @@ public:
   const static uint32_t required_major_firmware_version = 7;
   const static uint32_t required_minor_firmware_version = 1;
   const static uint32_t required_patch_firmware_version = 0;
+
+  //! Largest number of commands queued per dispatch in a burst, uhal splits them into packets
+  static const uint32_t kFLCmdBurstBatchSize; // NOLINT(build/unsigned)
 private:
   /**
   * @brief     Get the status tables.
   */
   std::string get_status_tables() const;
+
+  std::function<void(timingfirmwareinfo::MasterMonitorData&)> queue_monitor_data() const;
+
+  /**
+   * @brief     Queue the force pulses of a burst. The generator counters are only read, and dropped
+   *            commands only reported, if read_counters is set.
+   */
+  FLCmdBurstResult send_fl_cmd_pulses(uint32_t command,             // NOLINT(build/unsigned)
+                                      uint32_t channel,             // NOLINT(build/unsigned)
+                                      uint32_t number_of_commands,  // NOLINT(build/unsigned)
+                                      uint32_t log_sample_interval, // NOLINT(build/unsigned)
+                                      bool read_counters) const;
+
+  /**
+   * @brief     Switch on the endpoint SFP if requested, and reset the upstream receiver until it locks.
+   *
+   * @return    false if it did not lock within kUpstreamSettleTimeout, with the SFP switched back off.
+   */
+  bool connect_upstream_endpoint(uint16_t endpoint_address, bool control_sfp) const; // NOLINT(build/unsigned)
+
+  //! Time given to an endpoint transmitter and the upstream receiver to come up [ms]
+  static const uint32_t kUpstreamSettleTimeout; // NOLINT(build/unsigned)
+
+  //! Time given to the upstream receiver to lock after each reset, longer than the CDR lock time [ms]
+  static const uint32_t kUpstreamResetInterval; // NOLINT(build/unsigned)
+
+  //! Async reply latency assumed before any reply was seen [us]
+  static const int64_t kDefaultAsyncReplyLatency;
+
+  //! Shortest and longest wait between two async reply polls [us]
+  static const int64_t kMinAsyncPollInterval;
+  static const int64_t kMaxAsyncPollInterval;
+
+  // running average of the async reply latency [us], atomic as the node may be used from several threads
+  mutable std::atomic<int64_t> m_async_reply_latency;
 };
 
 } // namespace timing
@@ -55,8 +55,10 @@ public:
 
   /**
    * @brief     Set timestamp to current machine time
+   *
+   * @return     Round trip and residual offset of the synchronisation
    */
-  virtual void sync_timestamp(uint32_t clock_frequency_hz) const = 0; // NOLINT(build/unsigned)
+  virtual TimestampSyncResult sync_timestamp(uint32_t clock_frequency_hz) const = 0; // NOLINT(build/unsigned)
 
   /**
    * @brief     Control the tx line of endpoint sfp
@@ -117,6 +119,12 @@ public:
    */
   virtual timingfirmware::EndpointCheckResult scan_endpoint(uint16_t endpoint_address, bool control_sfp) const = 0;
 
+  /**
+   * @brief    Scan a list of endpoints, one after the other by default
+   */
+  virtual timingfirmware::EndpointCheckResultoVector scan_endpoints(const std::vector<uint16_t>& endpoint_addresses, // NOLINT(build/unsigned)
+                                                                    bool control_sfp) const;
+
   /**
    * @brief    Required major firmware version
    */
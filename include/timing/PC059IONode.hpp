@@ -15,6 +15,7 @@
 // PDT Headers
 #include "TimingIssues.hpp"
 #include "timing/FanoutIONode.hpp"
+#include "timing/I2C9546SwitchNode.hpp"
 #include "timing/timinghardwareinfo/InfoStructs.hpp"
 #include "timing/timinghardwareinfo/InfoNljs.hpp"
 
@@ -55,12 +56,12 @@ public:
   /**
    * @brief      Reset pc059 node.
    */
-  void reset(int32_t fanout_mode, const std::string& clock_config_file = "") const override; // NOLINT(build/unsigned)
+  void reset(int32_t fanout_mode, const std::string& clock_config_file = "", bool warm_restart = false) const override; // NOLINT(build/unsigned)
 
   /**
    * @brief      Reset pc059 node.
    */
-  void reset(const std::string& clock_config_file = "") const override;
+  void reset(const std::string& clock_config_file = "", bool warm_restart = false) const override;
 
   /**
    * @brief     Switch the SFP mux channel
@@ -73,10 +74,15 @@ public:
   uint32_t read_active_downstream_mux_channel() const override; // NOLINT(build/unsigned)
 
   /**
-   * @brief     Switch the SFP I2C mux channel
+   * @brief     Switch the SFP I2C mux channel, if not already selected
    */
   void switch_sfp_i2c_mux_channel(uint32_t sfp_id) const; // NOLINT(build/unsigned)
 
+  /**
+   * @brief     Reset the SFP I2C mux, e.g. to recover from a failed channel switch
+   */
+  void reset_sfp_i2c_mux() const;
+
   /**
    * @brief      Print status of on-board SFP.
    */
@@ -96,6 +102,15 @@ public:
    * @brief    Give info to collector.
    */
   void get_info(opmonlib::InfoCollector& ci, int level) const override;
+
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
+
+private:
+  std::function<void(timinghardwareinfo::TimingPC059MonitorData&)> queue_monitor_data() const;
+  InfoDecoder sample_i2c_info(int level) const override;
 };
 
 } // namespace timing
@@ -121,6 +121,11 @@ public:
    */
   void get_info(opmonlib::InfoCollector& ci, int level) const override;
 
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
+
   /**
    * @brief    Get the states map
    */
@@ -141,6 +146,9 @@ protected:
     { 0xd, "Error in time stamp check (0xd)" },                // 0b1101 when ERR_T; -- Error in time stamp check
     { 0xe, "Error in physical layer after lock (0xe)" },       // 0b1110 when ERR_P; -- Physical layer error after lock
   };
+
+private:
+  std::function<void(timingendpointinfo::TimingEndpointInfo&)> queue_monitor_data() const;
 };
 
 } // namespace timing
@@ -86,6 +86,14 @@ public:
    * @brief    Give info to collector.
    */
   void get_info(opmonlib::InfoCollector& ci, int level) const override;
+
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
+
+private:
+  std::function<void(timingendpointinfo::TimingEndpointInfo&)> queue_monitor_data() const;
 };
 
 } // namespace timing
@@ -68,7 +68,7 @@ public:
   /**
    * @brief     Set timestamp to current machine time
    */
-  void sync_timestamp(uint32_t clock_frequency_hz) const override; // NOLINT(build/unsigned)
+  TimestampSyncResult sync_timestamp(uint32_t clock_frequency_hz) const override; // NOLINT(build/unsigned)
 
   /**
    * @brief     Control the tx line of endpoint sfp
@@ -144,6 +144,11 @@ public:
    */
   void get_info(opmonlib::InfoCollector& ic, int level) const override;
 
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
+
   /**
    * @brief    Scan endpoint
    */
@@ -167,6 +172,8 @@ public:
   const static uint32_t required_major_firmware_version = 6;
   const static uint32_t required_minor_firmware_version = 4;
   const static uint32_t required_patch_firmware_version = 2;
+private:
+  std::function<void(timingfirmwareinfo::PDIMasterMonitorData&)> queue_monitor_data() const;
 };
 
 } // namespace timing
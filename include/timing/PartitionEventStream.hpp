@@ -0,0 +1,139 @@
+/**
+ * @file PartitionEventStream.hpp
+ *
+ * PartitionEventStream reads the events of a partition
+ * readout buffer as a continuous stream.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_PARTITIONEVENTSTREAM_HPP_
+#define TIMING_INCLUDE_TIMING_PARTITIONEVENTSTREAM_HPP_
+
+#include "timing/EventCapture.hpp"
+#include "timing/PartitionNode.hpp"
+
+// C++ Headers
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+/**
+ * @brief      Streaming reader of the partition readout buffer.
+ *
+ *             Each fetch reads the events counted by the previous fetch and queues the next
+ *             buffer count and flags in the same dispatch, so that a stream costs one round trip
+ *             per block of events. A count of less than one event is read again before use, as events
+ *             may have arrived since. Blocks go into two preallocated buffers used in turn: the events
+ *             handed out from one block stay valid while the next block is read.
+ *
+ *             Events are only read when the consumer asks for them, at most max_events_per_fetch
+ *             at a time; the rest stay in the firmware buffer, whose warning and error flags are
+ *             counted and reported when raised.
+ *
+ *               PartitionEventStream stream(partition);
+ *               for (const uint32_t* event : stream)
+ *                 process(event); // PartitionNode::kWordsPerEvent words
+ *
+ *             The iteration ends when the firmware buffer is empty; iterating again resumes the stream.
+ */
+class PartitionEventStream
+{
+public:
+  /**
+   * @brief      Input iterator over the events, until the firmware buffer runs empty.
+   */
+  class Iterator
+  {
+  public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef const uint32_t* value_type; // NOLINT(build/unsigned)
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+
+    explicit Iterator(PartitionEventStream* stream)
+      : m_stream(stream)
+      , m_event(stream ? stream->next() : nullptr)
+    {}
+
+    reference operator*() const { return m_event; }
+    Iterator& operator++()
+    {
+      m_event = m_stream->next();
+      return *this;
+    }
+    bool operator==(const Iterator& other) const { return m_event == other.m_event; }
+    bool operator!=(const Iterator& other) const { return m_event != other.m_event; }
+
+  private:
+    PartitionEventStream* m_stream;
+    const uint32_t* m_event; // NOLINT(build/unsigned)
+  };
+
+  explicit PartitionEventStream(const PartitionNode& partition, size_t max_events_per_fetch = kDefaultEventsPerFetch);
+
+  /**
+   * @brief      Record every event fetched into a capture file, nullptr to stop.
+   */
+  void set_capture_writer(EventCaptureWriter* writer);
+
+  /**
+   * @brief      Next event, nullptr if the firmware buffer is empty.
+   *
+   *             The event stays valid until the block after its own is fetched.
+   */
+  const uint32_t* next(); // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Read the next block of events, in a single dispatch.
+   *
+   * @return     Number of events read.
+   */
+  size_t fetch();
+
+  Iterator begin() { return Iterator(this); }
+  Iterator end() { return Iterator(nullptr); }
+
+  uint64_t get_event_count() const { return m_event_count; }          // NOLINT(build/unsigned)
+  uint64_t get_fetch_count() const { return m_fetch_count; }          // NOLINT(build/unsigned)
+  uint64_t get_buffer_warnings() const { return m_buffer_warnings; }  // NOLINT(build/unsigned)
+  uint64_t get_buffer_errors() const { return m_buffer_errors; }      // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Print the stream counters.
+   */
+  std::string get_status(bool print_out = false) const;
+
+  //! Default largest number of events read per fetch
+  static const size_t kDefaultEventsPerFetch;
+
+private:
+  const PartitionNode& m_partition;
+  const size_t m_max_events_per_fetch;
+  EventCaptureWriter* m_capture_writer;
+
+  std::function<PartitionBufferState()> m_buffer_state;
+  PartitionBufferState m_previous_state;
+
+  std::vector<uint32_t> m_buffers[2]; // NOLINT(build/unsigned)
+  size_t m_current;
+  size_t m_position;
+
+  uint64_t m_event_count;     // NOLINT(build/unsigned)
+  uint64_t m_fetch_count;     // NOLINT(build/unsigned)
+  uint64_t m_buffer_warnings; // NOLINT(build/unsigned)
+  uint64_t m_buffer_errors;   // NOLINT(build/unsigned)
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_PARTITIONEVENTSTREAM_HPP_
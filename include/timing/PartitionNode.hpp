@@ -24,6 +24,7 @@
 
 // C++ Headers
 #include <chrono>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -47,6 +48,13 @@ struct PartitionCounts
   std::vector<uint32_t> rejected; // NOLINT(build/unsigned)
 };
 
+struct PartitionBufferState
+{
+  uint32_t word_count; // NOLINT(build/unsigned)
+  bool warning;
+  bool error;
+};
+
 /**
  * @brief      Class for partition node.
  */
@@ -103,6 +111,16 @@ public:
    */
   std::vector<uint32_t> read_events(size_t number_of_events = 0) const; // NOLINT(build/unsigned)
 
+  /**
+   * @brief      Queue the reads of the buffer word count and flags, the returned function gives them after dispatch.
+   */
+  std::function<PartitionBufferState()> queue_buffer_state() const;
+
+  /**
+   * @brief      Queue the read of number_of_events events from the rob, valid after dispatch.
+   */
+  uhal::ValVector<uint32_t> queue_event_read(size_t number_of_events) const; // NOLINT(build/unsigned)
+
   /**
    * @brief      Enables the partition now.
    *
@@ -183,6 +201,38 @@ public:
    * @brief    Give info to collector.
    */
   void get_info(opmonlib::InfoCollector& ic, int level) const override;
+
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
+
+private:
+  std::function<void(timingfirmwareinfo::TimingPartitionMonitorData&)> queue_monitor_data() const;
+
+  enum Register
+  {
+    kCtrlPartEn,
+    kCtrlTrigEn,
+    kCtrlBufEn,
+    kCtrlRunReq,
+    kCtrlTrigCtrRst,
+    kCtrlRateCtrlEn,
+    kCtrlTrigMask,
+    kCtrlSpillGateEn,
+    kCtrlFragMask,
+    kStatInRun,
+    kStatInSpill,
+    kStatBufWarn,
+    kStatBufErr,
+    kBufCount,
+    kBufData,
+    kEvtCtr,
+    kAcceptedCounters,
+    kRejectedCounters,
+  };
+  static const std::vector<std::string> kRegisterPaths;
+  NodeHandleTable m_registers;
 };
 
 } // namespace timing
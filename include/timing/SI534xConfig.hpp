@@ -0,0 +1,122 @@
+/**
+ * @file SI534xConfig.hpp
+ *
+ * SI534xConfig is a class holding the compiled form of a
+ * ClockBuilder SI53xx configuration file.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_SI534XCONFIG_HPP_
+#define TIMING_INCLUDE_TIMING_SI534XCONFIG_HPP_
+
+#include "ers/Issue.hpp"
+
+#include <boost/tuple/tuple.hpp>
+
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace dunedaq {
+ERS_DECLARE_ISSUE(timing,                            ///< Namespace
+                  SI534xConfigError,                 ///< Issue class name
+                  " SI534xConfigError: " << message, ///< Message
+                  ((std::string)message)             ///< Message parameters
+)
+ERS_DECLARE_ISSUE(timing,                                    ///< Namespace
+                  SI534xMissingConfigSectionError,           ///< Issue class name
+                  " Missing configuration section: " << tag, ///< Message
+                  ((std::string)tag)                         ///< Message parameters
+)
+namespace timing {
+
+/**
+ * @class      SI534xConfig
+ *
+ * @brief      Compiled SI53xx configuration: design ID plus the preamble,
+ *             register and postamble sections as runs of consecutive
+ *             registers on the same page.
+ *
+ *             Compiled configurations are cached in a binary file keyed by
+ *             the hash of the text file content, so that later loads only
+ *             have to map the cache file instead of parsing the text.
+ *             The cache lives in a ".compiled" directory next to the text
+ *             file, or in $TIMING_CLOCK_CONFIG_CACHE if set.
+ */
+class SI534xConfig
+{
+public:
+  typedef boost::tuple<uint16_t, uint8_t> RegisterSetting_t; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Run of consecutive registers starting at address (page << 8 | register)
+   */
+  struct RegisterBlock
+  {
+    uint16_t address;          // NOLINT(build/unsigned)
+    std::vector<uint8_t> data; // NOLINT(build/unsigned)
+  };
+
+  SI534xConfig() = default;
+
+  /**
+   * @brief      Load a configuration file, from the compiled cache when available.
+   */
+  static SI534xConfig load(const std::string& filename);
+
+  /**
+   * @brief      Parse a ClockBuilder text configuration file.
+   */
+  static SI534xConfig parse(const std::string& filename);
+
+  /**
+   * @brief      Group register settings into runs of at most max_length consecutive registers on the same page.
+   */
+  static std::vector<RegisterBlock> make_blocks(const std::vector<RegisterSetting_t>& settings,
+                                                size_t max_length = kMaxBlockLength);
+
+  /**
+   * @brief      Expand register runs back into single register settings.
+   */
+  static std::vector<RegisterSetting_t> expand_blocks(const std::vector<RegisterBlock>& blocks);
+
+  /**
+   * @brief      Count the registers in a set of runs.
+   */
+  static size_t count_registers(const std::vector<RegisterBlock>& blocks);
+
+  const std::string& get_design_id() const { return m_design_id; }
+  const std::vector<RegisterBlock>& get_preamble() const { return m_preamble; }
+  const std::vector<RegisterBlock>& get_registers() const { return m_registers; }
+  const std::vector<RegisterBlock>& get_postamble() const { return m_postamble; }
+
+  //! Maximum number of consecutive registers in a run (i.e. written in a single I2C transaction)
+  static const size_t kMaxBlockLength;
+
+private:
+  static SI534xConfig parse(std::istream& file);
+  static std::string seek_header(std::istream& file);
+  static std::vector<RegisterSetting_t> read_config_section(std::istream& file, std::string tag);
+
+  static uint64_t hash_content(const std::string& content); // NOLINT(build/unsigned)
+  static std::string get_cache_path(const std::string& filename, uint64_t hash); // NOLINT(build/unsigned)
+
+  bool read_cache(const std::string& path, uint64_t hash);        // NOLINT(build/unsigned)
+  void write_cache(const std::string& path, uint64_t hash) const; // NOLINT(build/unsigned)
+
+  std::string m_design_id;
+  std::vector<RegisterBlock> m_preamble;
+  std::vector<RegisterBlock> m_registers;
+  std::vector<RegisterBlock> m_postamble;
+
+  static const char kCacheMagic[8];
+  static const uint32_t kCacheVersion; // NOLINT(build/unsigned)
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_SI534XCONFIG_HPP_
@@ -13,6 +13,7 @@
 #define TIMING_INCLUDE_TIMING_SI534XNODE_HPP_
 
 #include "timing/I2CMasterNode.hpp"
+#include "timing/SI534xConfig.hpp"
 #include "timing/SIChipSlave.hpp"
 #include "timing/timinghardwareinfo/InfoStructs.hpp"
 
@@ -21,24 +22,33 @@
 #include <map>
 #include <string>
 #include <vector>
-#include <boost/tuple/tuple.hpp>
 
 namespace dunedaq {
-ERS_DECLARE_ISSUE(timing,                            ///< Namespace
-                  SI534xConfigError,                 ///< Issue class name
-                  " SI534xConfigError: " << message, ///< Message
-                  ((std::string)message)             ///< Message parameters
-)
-ERS_DECLARE_ISSUE(timing,                                    ///< Namespace
-                  SI534xMissingConfigSectionError,           ///< Issue class name
-                  " Missing configuration section: " << tag, ///< Message
-                  ((std::string)tag)                         ///< Message parameters
-)
 ERS_DECLARE_ISSUE(timing,                                                          ///< Namespace
                   SI534xRegWriteFailed,                                            ///< Issue class name
                   " Failed to write Si53xx reg: " << reg << "with data: " << data, ///< Message
                   ((std::string)reg)((std::string)data)                            ///< Message parameters
 )
+ERS_DECLARE_ISSUE(timing,                                                                                  ///< Namespace
+                  SI534xBurstWriteFailed,                                                                  ///< Issue class name
+                  " Failed to write " << size << " Si53xx regs from " << reg << ", writing them one by one", ///< Message
+                  ((std::string)reg)((size_t)size)                                                         ///< Message parameters
+)
+ERS_DECLARE_ISSUE(timing,                                                                                ///< Namespace
+                  SI534xDifferentialConfigFailed,                                                        ///< Issue class name
+                  " Differential configuration of " << design_id << " failed, uploading the full configuration", ///< Message
+                  ((std::string)design_id)                                                               ///< Message parameters
+)
+ERS_DECLARE_ISSUE(timing,                                                             ///< Namespace
+                  SI534xCalibrationTimeout,                                           ///< Issue class name
+                  " Si53xx still calibrating after " << timeout << " milliseconds", ///< Message
+                  ((uint32_t)timeout)                                                 ///< Message parameters
+)
+ERS_DECLARE_ISSUE(timing,                                                                ///< Namespace
+                  SI534xLockTimeout,                                                     ///< Issue class name
+                  " Si53xx not locked " << timeout << " milliseconds after calibration", ///< Message
+                  ((uint32_t)timeout)                                                    ///< Message parameters
+)
 ERS_DECLARE_ISSUE(timing,                                    ///< Namespace
                   SI534xRegWriteRetry,                       ///< Issue class name
                   "Retry " << attempt << " for reg " << reg, ///< Message
@@ -59,21 +69,69 @@ public:
   SI534xSlave(const I2CMasterNode* i2c_master, uint8_t i2c_device_address); // NOLINT(build/unsigned)
   virtual ~SI534xSlave();
 
-  void configure(const std::string& filename) const;
+  /**
+   * @brief      Configure the chip from a ClockBuilder configuration file.
+   *
+   * @param[in]  filename      The configuration file
+   * @param[in]  warm_restart  Skip the upload if the chip already runs the design and is locked,
+   *                           otherwise write only the registers that differ from the chip content.
+   * @param[in]  settle_timeout  Maximum time to wait for each chip calibration, in milliseconds
+   */
+  void configure(const std::string& filename,
+                 bool warm_restart = false,
+                 uint32_t settle_timeout = 2000) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Time spent waiting for the chip to calibrate during the last configure, in milliseconds.
+   */
+  uint32_t get_settle_time() const; // NOLINT(build/unsigned)
 
   std::map<uint16_t, uint8_t> registers() const; // NOLINT(build/unsigned)
 
   std::string read_config_id() const;
 
+  /**
+   * @brief      Read the status registers 0xc-0x12 in a single I2C transaction.
+   *
+   * @return     The register values, starting from 0xc
+   */
+  std::vector<uint8_t> read_status_registers() const; // NOLINT(build/unsigned)
+
   void get_info(timinghardwareinfo::TimingPLLMonitorData& mon_data) const;
 
 private:
-  typedef boost::tuple<uint16_t, uint8_t> RegisterSetting_t; // NOLINT(build/unsigned)
+  typedef SI534xConfig::RegisterSetting_t RegisterSetting_t;
+
+  void upload_config_full(const SI534xConfig& config, uint32_t settle_timeout) const; // NOLINT(build/unsigned)
+
+  void upload_config_differential(const SI534xConfig& config, uint32_t settle_timeout) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Wait for the chip to calibrate, and optionally to lock (LOL clear).
+   *
+   * @param[in]  timeout        Maximum time to wait, in milliseconds
+   * @param[in]  wait_for_lock  Also wait for LOL to clear, only a warning is reported if it does not
+   *
+   * @return     The time spent waiting, in milliseconds
+   */
+  uint32_t wait_for_calibration(uint32_t timeout, bool wait_for_lock = false) const; // NOLINT(build/unsigned)
+
+  bool is_locked() const;
+
+  std::vector<SI534xConfig::RegisterBlock> find_changed_registers(
+    const std::vector<SI534xConfig::RegisterBlock>& config) const;
+
+  void upload_config(const std::vector<SI534xConfig::RegisterBlock>& config) const;
+
+  void upload_setting(const RegisterSetting_t& setting) const;
+
+  //! Interval between two reads of the calibration status, in milliseconds
+  static const uint32_t kCalibrationPollInterval; // NOLINT(build/unsigned)
 
-  std::string seek_header(std::ifstream& file) const;
-  std::vector<RegisterSetting_t> read_config_section(std::ifstream& file, std::string tag) const;
+  //! Time after which SYSINCAL clear is trusted even if it was never seen set, in milliseconds
+  static const uint32_t kCalibrationMinTime; // NOLINT(build/unsigned)
 
-  void upload_config(const std::vector<SI534xSlave::RegisterSetting_t>& config) const;
+  mutable uint32_t m_settle_time; // NOLINT(build/unsigned)
 };
 
 /**
@@ -17,8 +17,15 @@
 #include "ers/Issue.hpp"
 
 #include <map>
+#include <vector>
 
 namespace dunedaq {
+ERS_DECLARE_ISSUE(timing,                                                                           ///< Namespace
+                  SIChipPageBoundaryCrossed,                                                        ///< Issue class name
+                  " Register block of " << size << " bytes from " << address << " crosses a page boundary", ///< Message
+                  ((std::string)address)((size_t)size)                                               ///< Message parameters
+)
+
 namespace timing {
 
 /**
@@ -35,19 +42,25 @@ public:
   virtual ~SIChipSlave();
 
   /**
-   * @brief      Reads the current page.
+   * @brief      Reads the current page from the chip and refreshes the cached page.
    *
    * @return     { description_of_the_return_value }
    */
   uint8_t read_page() const; // NOLINT(build/unsigned)
 
   /**
-   * @brief      { function_description }
+   * @brief      Writes the page register and records the new active page.
    *
    * @param[in]  page  A page
    */
   void switch_page(uint8_t page) const; // NOLINT(build/unsigned)
 
+  /**
+   * @brief      Forget the cached active page, e.g. after a chip reset.
+   *             The next register access re-reads the page from the chip.
+   */
+  void invalidate_page_cache() const;
+
   /**
    * @brief      Reads a device version.
    *
@@ -71,6 +84,40 @@ public:
    * @param[in]  data  A data
    */
   void write_clock_register(uint16_t address, uint8_t data) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Reads a block of consecutive clock registers in a single I2C transaction,
+   *             relying on the chip's register address auto-increment.
+   *
+   * @param[in]  address          Address of the first register
+   * @param[in]  number_of_words  Number of registers. The block must not cross a page boundary.
+   *
+   * @return     The register values
+   */
+  std::vector<uint8_t> read_clock_registers(uint16_t address, uint32_t number_of_words) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Writes a block of consecutive clock registers in a single I2C transaction,
+   *             relying on the chip's register address auto-increment.
+   *
+   * @param[in]  address  Address of the first register
+   * @param[in]  data     Register values. The block must not cross a page boundary.
+   */
+  void write_clock_registers(uint16_t address, const std::vector<uint8_t>& data) const; // NOLINT(build/unsigned)
+
+protected:
+  /**
+   * @brief      Make sure the chip is on the requested page, using the cached page when known.
+   *
+   * @param[in]  page  A page
+   */
+  void select_page(uint8_t page) const; // NOLINT(build/unsigned)
+
+private:
+  static const int32_t kUnknownPage = -1;
+
+  //! Last page read from or written to the chip, kUnknownPage if not known
+  mutable int32_t m_active_page;
 };
 
 } // namespace timing
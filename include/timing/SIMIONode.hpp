@@ -65,13 +65,13 @@ public:
   /**
    * @brief      Reset timing node.
    */
-  void reset(const std::string& clock_config_file = "") const override;
+  void reset(const std::string& clock_config_file = "", bool warm_restart = false) const override;
 
   /**
    * @brief     Reset fanout board
    */
   void reset(int32_t fanout_mode = -1, // NOLINT(build/unsigned)
-                     const std::string& clock_config_file = "") const override;
+                     const std::string& clock_config_file = "", bool warm_restart = false) const override;
 
   /**
    * @brief      Read the word containing the timing board UID.
@@ -83,7 +83,7 @@ public:
   /**
    * @brief      Configure clock chip.
    */
-  void configure_pll(const std::string& clock_config_file = "") const override;
+  void configure_pll(const std::string& clock_config_file = "", bool warm_restart = false) const override;
 
   /**
    * @brief      Read frequencies of on-board clocks.
@@ -55,13 +55,13 @@ public:
   /**
    * @brief      Reset timing node.
    */
-  void reset(const std::string& clock_config_file = "") const override;
+  void reset(const std::string& clock_config_file = "", bool warm_restart = false) const override;
 
   /**
    * @brief     Reset fanout board
    */
   void reset(int32_t fanout_mode = -1, // NOLINT(build/unsigned)
-                     const std::string& clock_config_file = "") const override;
+                     const std::string& clock_config_file = "", bool warm_restart = false) const override;
   /**
    * @brief      Configure on-board DAC
    */
@@ -87,8 +87,16 @@ public:
    */
   void get_info(opmonlib::InfoCollector& ci, int level) const override;
 
+  /**
+   * @brief    Queue the monitoring reads, see TimingNode::queue_info.
+   */
+  InfoDecoder queue_info(int level) const override;
+
 protected:
   const std::vector<std::string> m_dac_devices;
+
+private:
+  std::function<void(timinghardwareinfo::TimingTLUMonitorData&)> queue_monitor_data() const;
 };
 
 } // namespace timing
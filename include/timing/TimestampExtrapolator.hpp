@@ -0,0 +1,156 @@
+/**
+ * @file TimestampExtrapolator.hpp
+ *
+ * TimestampExtrapolator serves the current timing system timestamp
+ * from a fit of periodic hardware reads against the host clock.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_TIMESTAMPEXTRAPOLATOR_HPP_
+#define TIMING_INCLUDE_TIMING_TIMESTAMPEXTRAPOLATOR_HPP_
+
+// C++ Headers
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace dunedaq {
+namespace timing {
+
+/**
+ * @brief      Host clock extrapolated timestamp reader.
+ *
+ *             A background thread reads the hardware timestamp once per period and fits the
+ *             last samples against std::chrono::steady_clock. read_timestamp then extrapolates
+ *             the fit without any IPbus transaction. A sample further than the resync threshold
+ *             from the fit (e.g. the timestamp was set, or the clocks drifted apart) drops the
+ *             history, and the fit restarts from that sample.
+ *
+ *             Typical use, with a master node and the firmware frequency of the IO node:
+ *
+ *               TimestampExtrapolator tstamp([&master]() { return master.read_timestamp(); }, frequency_hz);
+ *               tstamp.start();
+ *               auto now = tstamp.read_timestamp();
+ *
+ *             The python bindings construct it directly from a master or endpoint node.
+ */
+class TimestampExtrapolator
+{
+public:
+  typedef std::function<uint64_t()> ReadFunction; // NOLINT(build/unsigned)
+
+  /**
+   * @param[in]  read_timestamp     Dispatched read of the hardware timestamp
+   * @param[in]  clock_frequency_hz Timestamp counter frequency
+   * @param[in]  period             Time between hardware reads
+   * @param[in]  resync_threshold   Largest accepted distance between a new sample and the fit
+   */
+  TimestampExtrapolator(ReadFunction read_timestamp,
+                        uint32_t clock_frequency_hz, // NOLINT(build/unsigned)
+                        std::chrono::milliseconds period = std::chrono::milliseconds(100),
+                        std::chrono::nanoseconds resync_threshold = std::chrono::microseconds(10));
+  TimestampExtrapolator(const TimestampExtrapolator&) = delete;
+  TimestampExtrapolator& operator=(const TimestampExtrapolator&) = delete;
+  ~TimestampExtrapolator();
+
+  /**
+   * @brief      Take a first sample and start the periodic reads.
+   */
+  void start();
+
+  /**
+   * @brief      Stop the periodic reads. The fit is kept, but its error bound keeps growing.
+   */
+  void stop();
+
+  bool is_running() const;
+
+  /**
+   * @brief      Drop the fit and restart it from a new sample.
+   */
+  void resync();
+
+  /**
+   * @brief      Extrapolated timestamp, in clock ticks. Reads the hardware when there is no fit yet.
+   */
+  uint64_t read_timestamp() const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Extrapolated timestamp, in nanoseconds since the timestamp epoch, at the nominal clock frequency.
+   */
+  uint64_t read_timestamp_ns() const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Bound on the error of read_timestamp, from the read round trips, the fit residuals and
+   *             the assumed clock drift since the last sample.
+   */
+  std::chrono::nanoseconds get_error_bound() const;
+
+  /**
+   * @brief      Measured timestamp clock frequency, from the fit slope. The nominal one without a fit.
+   */
+  double get_fitted_frequency() const;
+
+  uint64_t get_resync_count() const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Print the state of the fit.
+   */
+  std::string get_status(bool print_out = false) const;
+
+  //! Number of samples in the fit
+  static const size_t kFitSamples;
+
+  //! Drift assumed between the host and timing clocks when extrapolating [ppm]
+  static const double kDriftPPM;
+
+private:
+  struct Sample
+  {
+    int64_t host_time_ns;      // middle of the read round trip
+    uint64_t timestamp;        // NOLINT(build/unsigned)
+    int64_t uncertainty_ns;    // half of the read round trip
+  };
+
+  static int64_t host_time_ns();
+  Sample take_sample() const;
+
+  // the following are called with m_mutex held
+  void add_sample(const Sample& sample);
+  void fit();
+  double extrapolate(int64_t host_time_ns) const;
+
+  void run();
+
+  const ReadFunction m_read_timestamp;
+  const uint32_t m_clock_frequency_hz; // NOLINT(build/unsigned)
+  const double m_nominal_ticks_per_ns;
+  const std::chrono::milliseconds m_period;
+  const std::chrono::nanoseconds m_resync_threshold;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_stop_condition;
+  bool m_stop;
+  std::thread m_thread;
+
+  std::deque<Sample> m_samples;
+  // fit: timestamp = m_fit_origin.timestamp + m_fit_offset + m_fit_slope * (host_time_ns - m_fit_origin.host_time_ns)
+  Sample m_fit_origin;
+  double m_fit_offset;
+  double m_fit_slope;
+  int64_t m_fit_error_ns;
+  uint64_t m_resync_count; // NOLINT(build/unsigned)
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_TIMESTAMPEXTRAPOLATOR_HPP_
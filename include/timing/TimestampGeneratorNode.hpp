@@ -26,6 +26,16 @@
 namespace dunedaq {
 namespace timing {
 
+/**
+ * @brief      Outcome of a timestamp synchronisation to the host clock.
+ */
+struct TimestampSyncResult
+{
+  int64_t round_trip_ns;       // shortest probe round trip
+  int64_t residual_offset_ns;  // timestamp minus host clock, measured after the sync
+  double frequency_error_ppm;  // timestamp clock rate against the host clock, fitted over the read backs
+};
+
 /**
  * @brief      Class for timestamp generator node.
  */
@@ -59,6 +69,26 @@ public:
    * @brief      Read the current timestamp words.
    */
   void set_timestamp(uint64_t timestamp) const; // NOLINT(build/unsigned)
+
+  /**
+   * @brief      Set the timestamp to the host time (since the epoch), aiming the write at its arrival time.
+   *
+   *             The IPbus round trip is measured over a number of probe reads, the timestamp is computed
+   *             for the predicted arrival of the write, and the result is checked with a fit of read backs,
+   *             kSyncReadBackInterval apart, against the host clock. Round trips are timed on the steady clock.
+   *             At least two probes are used.
+   */
+  TimestampSyncResult sync_timestamp(uint32_t clock_frequency_hz, uint32_t probes = 8) const; // NOLINT(build/unsigned)
+
+  //! Time between the read backs fitted after a sync
+  static const std::chrono::milliseconds kSyncReadBackInterval;
+
+  //! Fitted frequency error above which the sync is reported [ppm]
+  static const double kMaxSyncFrequencyErrorPPM;
+
+private:
+  static uint64_t host_time_to_timestamp(std::chrono::system_clock::time_point time, // NOLINT(build/unsigned)
+                                         uint32_t clock_frequency_hz);               // NOLINT(build/unsigned)
 };
 
 } // namespace timing
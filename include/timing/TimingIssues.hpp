@@ -254,6 +254,11 @@ ERS_DECLARE_ISSUE(timing,
 
 ERS_DECLARE_ISSUE(timing, HSIBufferIssue, "HSI buffer in state: " << buffer_state, ((std::string)buffer_state))
 
+ERS_DECLARE_ISSUE(timing,
+                  PartitionBufferIssue,
+                  "Partition buffer in state: " << buffer_state,
+                  ((std::string)buffer_state))
+
 ERS_DECLARE_ISSUE(timing,                                                                       ///< Namespace
                   EnclustraSwitchFailure,                                                       ///< Issue class name
                   " Failed to program Enclustra I2C IO expander. FMC I2C access may not work.", ///< Message
@@ -330,11 +335,53 @@ ERS_DECLARE_ISSUE(timing,
                   ((uint16_t)ept_address)((uint32_t)ept_state)                                                                    ///< Message parameters
 )
 
+ERS_DECLARE_ISSUE(timing,                                                                 ///< Namespace
+                  EndpointScanFailed,                                                     ///< Issue class name
+                  "Scan of the endpoint at address 0x" << std::hex << ept_address << " failed", ///< Message
+                  ((uint16_t)ept_address)                                                 ///< Message parameters
+)
+
 ERS_DECLARE_ISSUE(timing,                                               //< Namespace
                   EndpointBroadcastMessageCountersNotReady,             ///< Issue class name
                   "Endpoint broadcast message counters are not ready!", ///< Message
                   ERS_EMPTY                                             ///< Message parameters
 )
+
+ERS_DECLARE_ISSUE(timing,                                    ///< Namespace
+                  DeferredDispatchFailed,                    ///< Issue class name
+                  "Failed to dispatch deferred transactions", ///< Message
+                  ERS_EMPTY                                  ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                   ///< Namespace
+                  I2CInfoSampleFailed,                      ///< Issue class name
+                  "Failed to sample I2C monitoring data",   ///< Message
+                  ERS_EMPTY                                 ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                            ///< Namespace
+                  FixedLengthCommandsDropped,                                        ///< Issue class name
+                  dropped << " of " << sent << " fixed length commands were not accepted", ///< Message
+                  ((uint32_t)dropped)((uint32_t)sent)                                ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                   ///< Namespace
+                  TimestampSampleFailed,                    ///< Issue class name
+                  "Failed to read the timestamp for extrapolation", ///< Message
+                  ERS_EMPTY                                 ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                   ///< Namespace
+                  HSIReadoutFailed,                         ///< Issue class name
+                  "Failed to read out the HSI buffer",      ///< Message
+                  ERS_EMPTY                                 ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  TimestampRateMismatch,                                                   ///< Issue class name
+                  "Timestamp counter runs " << error_ppm << " ppm off the host clock after the sync", ///< Message
+                  ((double)error_ppm)                                                      ///< Message parameters
+)
 } // namespace dunedaq
 
 #endif // TIMING_INCLUDE_TIMING_TIMINGISSUES_HPP_
\ No newline at end of file
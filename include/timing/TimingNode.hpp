@@ -19,13 +19,81 @@
 #include "ers/Issue.hpp"
 
 // C++ Headers
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
+
+/**
+ * @brief      Table of register nodes resolved on first use, addressed by a per-class enum.
+ *
+ *             The table holds pointers into the node tree of its owner, so copies
+ *             (i.e. uhal node clones) start empty and resolve against their own tree.
+ */
+class NodeHandleTable
+{
+public:
+  explicit NodeHandleTable(const std::vector<std::string>& paths);
+  NodeHandleTable(const NodeHandleTable& other);
+  NodeHandleTable& operator=(const NodeHandleTable&) = delete;
+
+  /**
+   * @brief     Get the node for register id, relative to parent.
+   */
+  const uhal::Node& get(const uhal::Node& parent, size_t id) const;
+
+  size_t size() const { return m_paths.size(); }
+
+private:
+  const std::vector<std::string>& m_paths;
+  std::unique_ptr<std::atomic<const uhal::Node*>[]> m_handles;
+};
+
+/**
+ * @brief      Scope in which the dispatches of write-only timing node methods are deferred,
+ *             and flushed in a single dispatch when the outermost scope exits.
+ *
+ *             Methods that need the value of a read still dispatch straight away, which also
+ *             sends the writes queued before them, so returned values are always valid.
+ *             Scopes apply to the calling thread and the client of the given node, and nest.
+ *
+ *             End every scope with flush(), so that a failed dispatch reaches the caller. The
+ *             outermost scope still dispatches on exit: a failure there is thrown, unless the
+ *             scope exits by exception, in which case it is only reported.
+ */
+class DeferredDispatchScope
+{
+public:
+  explicit DeferredDispatchScope(const uhal::Node& node);
+  ~DeferredDispatchScope() noexcept(false);
+
+  DeferredDispatchScope(const DeferredDispatchScope&) = delete;
+  DeferredDispatchScope& operator=(const DeferredDispatchScope&) = delete;
+
+  /**
+   * @brief     Dispatch the transactions queued so far, throwing on failure.
+   */
+  void flush() const;
+
+  /**
+   * @brief     Whether dispatches on client are deferred in this thread.
+   */
+  static bool is_active(const uhal::ClientInterface& client);
+
+private:
+  uhal::ClientInterface& m_client;
+  const int m_uncaught_exceptions;
+
+  static thread_local std::map<const uhal::ClientInterface*, uint32_t> s_depths; // NOLINT(build/unsigned)
+};
+
 /**
  * @brief      Base class for timing nodes.
  */
@@ -36,6 +104,11 @@ public:
   explicit TimingNode(const uhal::Node& node);
   virtual ~TimingNode();
 
+  /**
+   * @brief     Decodes reads queued by queue_info into a collector, once they have been dispatched.
+   */
+  typedef std::function<void(opmonlib::InfoCollector&)> InfoDecoder;
+
   /**
    * @brief     Get the status string of the timing node. Optionally print it
    */
@@ -47,6 +120,14 @@ public:
   std::map<std::string, uhal::ValWord<uint32_t>> read_sub_nodes(const uhal::Node& node, // NOLINT(build/unsigned)
                                                                 bool dispatch = true) const;
 
+  /**
+   * @brief     Read registers from a handle table into a flat vector indexed by register id.
+   *            Only the requested ids are read, other entries are left empty.
+   */
+  std::vector<uhal::ValWord<uint32_t>> read_sub_nodes(const NodeHandleTable& registers, // NOLINT(build/unsigned)
+                                                      const std::vector<size_t>& ids,
+                                                      bool dispatch = true) const;
+
   /**
    * @brief     Reset subnodes.
    */
@@ -58,6 +139,30 @@ public:
    * @brief    Give info to collector.
    */
   virtual void get_info(opmonlib::InfoCollector&, int) const {}
+
+  /**
+   * @brief     First phase of get_info: queue the register reads without dispatching them.
+   *            The returned decoder is to be called after the next dispatch.
+   *            Nodes which do not override this fall back to get_info in the decoder.
+   */
+  virtual InfoDecoder queue_info(int level) const;
+
+protected:
+  /**
+   * @brief     get_info in one dispatch: queue_info, dispatch, decode.
+   */
+  void collect_info(opmonlib::InfoCollector& ci, int level) const;
+
+  /**
+   * @brief     Run a decoder into the child collector name of ci.
+   */
+  static void decode_info(opmonlib::InfoCollector& ci, const std::string& name, const InfoDecoder& decoder);
+
+  /**
+   * @brief     Dispatch queued writes, unless inside a DeferredDispatchScope.
+   *            Not to be used where the value of a queued read is needed.
+   */
+  void dispatch_writes() const;
 };
 
 } // namespace timing
@@ -58,18 +58,19 @@ public:
   /**
    * @brief      Reset timing node.
    */
-  void reset_io(const std::string& clock_config_file = "") const override
+  void reset_io(const std::string& clock_config_file = "", bool warm_restart = false) const override
   {
-    get_io_node_plain()->reset(clock_config_file);
+    get_io_node_plain()->reset(clock_config_file, warm_restart);
   }
 
   /**
    * @brief      Reset timing node.
    */
   void reset_io(int32_t fanout_mode, // NOLINT(build/unsigned)
-                        const std::string& clock_config_file = "") const override
+                        const std::string& clock_config_file = "",
+                        bool warm_restart = false) const override
   {
-    get_io_node_plain()->reset(fanout_mode, clock_config_file);
+    get_io_node_plain()->reset(fanout_mode, clock_config_file, warm_restart);
   }
 
   /**
@@ -60,13 +60,14 @@ public:
   /**
    * @brief      Reset timing node.
    */
-  virtual void reset_io(const std::string& clock_config_file = "") const = 0;
+  virtual void reset_io(const std::string& clock_config_file = "", bool warm_restart = false) const = 0;
 
   /**
    * @brief      Reset timing node.
    */
   virtual void reset_io(int32_t fanout_mode, // NOLINT(build/unsigned)
-                        const std::string& clock_config_file = "") const = 0;
+                        const std::string& clock_config_file = "",
+                        bool warm_restart = false) const = 0;
 
   /**
    * @brief      Prepare the timing device for data taking.
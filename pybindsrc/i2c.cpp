@@ -59,7 +59,8 @@ register_i2c(py::module& m)
     .def("get_slave_address", &timing::I2CMasterNode::get_slave_address)
     .def("ping", &timing::I2CMasterNode::ping)
     .def("scan", &timing::I2CMasterNode::scan)
-    .def("reset", &timing::I2CMasterNode::reset);
+    .def("reset", &timing::I2CMasterNode::reset)
+    .def("invalidate_core_state", &timing::I2CMasterNode::invalidate_core_state);
 
   // Wrap timing::I2CSlave
   py::class_<timing::I2CSlave>(m, "I2CSlave")
@@ -107,15 +108,23 @@ register_i2c(py::module& m)
     .def(py::init<const timing::I2CMasterNode*, uint8_t>()) // NOLINT(build/unsigned)
     .def("read_page", &timing::SIChipSlave::read_page)
     .def("switch_page", &timing::SIChipSlave::switch_page)
+    .def("invalidate_page_cache", &timing::SIChipSlave::invalidate_page_cache)
     .def("read_device_version", &timing::SIChipSlave::read_device_version)
     .def("read_clock_register", &timing::SIChipSlave::read_clock_register)
-    .def("write_clock_register", &timing::SIChipSlave::write_clock_register);
+    .def("write_clock_register", &timing::SIChipSlave::write_clock_register)
+    .def("read_clock_registers", &timing::SIChipSlave::read_clock_registers);
 
   // Wrap SI534xSlave
   py::class_<timing::SI534xSlave, timing::SIChipSlave>(m, "SI534xSlave")
     .def(py::init<const timing::I2CMasterNode*, uint8_t>()) // NOLINT(build/unsigned)
-    .def("configure", &timing::SI534xSlave::configure)
+    .def("configure",
+         &timing::SI534xSlave::configure,
+         py::arg("filename"),
+         py::arg("warm_restart") = false,
+         py::arg("settle_timeout") = 2000)
+    .def("get_settle_time", &timing::SI534xSlave::get_settle_time)
     .def("read_config_id", &timing::SI534xSlave::read_config_id)
+    .def("read_status_registers", &timing::SI534xSlave::read_status_registers)
     // .def("registers", &timing::SI534xSlave::registers)
     ;
 
@@ -130,6 +139,15 @@ register_i2c(py::module& m)
     .def("set_inversion", &timing::I2CExpanderSlave::set_inversion)
     .def("set_outputs", &timing::I2CExpanderSlave::set_outputs)
     .def("read_inputs", &timing::I2CExpanderSlave::read_inputs)
+    .def("read_outputs_config", &timing::I2CExpanderSlave::read_outputs_config)
+    .def("set_output_bit",
+         &timing::I2CExpanderSlave::set_output_bit,
+         py::arg("bank_id"),
+         py::arg("bit"),
+         py::arg("value"),
+         py::arg("resync") = false)
+    .def("resync", &timing::I2CExpanderSlave::resync)
+    .def("invalidate_shadow", py::overload_cast<>(&timing::I2CExpanderSlave::invalidate_shadow, py::const_))
     .def("debug", &timing::I2CExpanderSlave::debug);
 
 //  // Wrap I2CExpanderNode
@@ -15,6 +15,7 @@
 #include "timing/MIBIONode.hpp"
 #include "timing/SwitchyardNode.hpp"
 
+#include <pybind11/chrono.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -30,12 +31,15 @@ void
 register_io(py::module& m)
 {
 
-  py::class_<timing::IONode, uhal::Node>(m, "IONode");
+  py::class_<timing::IONode, uhal::Node>(m, "IONode")
+    .def("configure_pll", &timing::IONode::configure_pll, py::arg("clock_config_file") = "", py::arg("warm_restart") = false)
+    .def("start_i2c_info_sampler", &timing::IONode::start_i2c_info_sampler, py::arg("period"))
+    .def("stop_i2c_info_sampler", &timing::IONode::stop_i2c_info_sampler);
 
   py::class_<timing::FMCIONode, timing::IONode, uhal::Node>(m, "FMCIONode")
     .def(py::init<const uhal::Node&>())
-    .def<void (timing::FMCIONode::*)(const std::string&) const>(
-      "reset", &timing::FMCIONode::reset, py::arg("clock_config_file") = "")
+    .def<void (timing::FMCIONode::*)(const std::string&, bool) const>(
+      "reset", &timing::FMCIONode::reset, py::arg("clock_config_file") = "", py::arg("warm_restart") = false)
     .def("soft_reset", &timing::FMCIONode::soft_reset)
     .def("read_firmware_frequency", &timing::FMCIONode::read_firmware_frequency)
     .def("get_clock_frequencies_table", &timing::FMCIONode::get_clock_frequencies_table, py::arg("print_out") = false)
@@ -47,10 +51,10 @@ register_io(py::module& m)
 
   py::class_<timing::PC059IONode, timing::IONode, uhal::Node>(m, "PC059IONode")
     .def(py::init<const uhal::Node&>())
-    .def<void (timing::PC059IONode::*)(const std::string&) const>(
-      "reset", &timing::PC059IONode::reset, py::arg("clock_config_file") = "")
-    .def<void (timing::PC059IONode::*)(int32_t, const std::string&) const>(
-      "reset", &timing::PC059IONode::reset, py::arg("fanout_mode"), py::arg("clock_config_file") = "")
+    .def<void (timing::PC059IONode::*)(const std::string&, bool) const>(
+      "reset", &timing::PC059IONode::reset, py::arg("clock_config_file") = "", py::arg("warm_restart") = false)
+    .def<void (timing::PC059IONode::*)(int32_t, const std::string&, bool) const>(
+      "reset", &timing::PC059IONode::reset, py::arg("fanout_mode"), py::arg("clock_config_file") = "", py::arg("warm_restart") = false)
     .def("soft_reset", &timing::PC059IONode::soft_reset)
     .def("read_firmware_frequency", &timing::PC059IONode::read_firmware_frequency)
     .def("get_clock_frequencies_table", &timing::PC059IONode::get_clock_frequencies_table, py::arg("print_out") = false)
@@ -64,10 +68,10 @@ register_io(py::module& m)
 
     py::class_<timing::FIBIONode, timing::IONode, uhal::Node>(m, "FIBIONode")
     .def(py::init<const uhal::Node&>())
-    .def<void (timing::FIBIONode::*)(const std::string&) const>(
-      "reset", &timing::FIBIONode::reset, py::arg("clock_config_file") = "")
-    .def<void (timing::FIBIONode::*)(int32_t, const std::string&) const>(
-      "reset", &timing::FIBIONode::reset, py::arg("fanout_mode"), py::arg("clock_config_file") = "")
+    .def<void (timing::FIBIONode::*)(const std::string&, bool) const>(
+      "reset", &timing::FIBIONode::reset, py::arg("clock_config_file") = "", py::arg("warm_restart") = false)
+    .def<void (timing::FIBIONode::*)(int32_t, const std::string&, bool) const>(
+      "reset", &timing::FIBIONode::reset, py::arg("fanout_mode"), py::arg("clock_config_file") = "", py::arg("warm_restart") = false)
     .def("soft_reset", &timing::FIBIONode::soft_reset)
     .def("read_firmware_frequency", &timing::FIBIONode::read_firmware_frequency)
     .def("get_clock_frequencies_table", &timing::FIBIONode::get_clock_frequencies_table, py::arg("print_out") = false)
@@ -81,8 +85,8 @@ register_io(py::module& m)
 
   py::class_<timing::TLUIONode, timing::IONode, uhal::Node>(m, "TLUIONode")
     .def(py::init<const uhal::Node&>())
-    .def<void (timing::TLUIONode::*)(const std::string&) const>(
-      "reset", &timing::TLUIONode::reset, py::arg("clock_config_file") = "")
+    .def<void (timing::TLUIONode::*)(const std::string&, bool) const>(
+      "reset", &timing::TLUIONode::reset, py::arg("clock_config_file") = "", py::arg("warm_restart") = false)
     .def("soft_reset", &timing::TLUIONode::soft_reset)
     .def("read_firmware_frequency", &timing::TLUIONode::read_firmware_frequency)
     .def("get_clock_frequencies_table", &timing::TLUIONode::get_clock_frequencies_table, py::arg("print_out") = false)
@@ -99,8 +103,8 @@ register_io(py::module& m)
 
   py::class_<timing::SIMIONode, timing::IONode, uhal::Node>(m, "SIMIONode")
     .def(py::init<const uhal::Node&>())
-    .def<void (timing::SIMIONode::*)(const std::string&) const>(
-      "reset", &timing::SIMIONode::reset, py::arg("clock_config_file") = "")
+    .def<void (timing::SIMIONode::*)(const std::string&, bool) const>(
+      "reset", &timing::SIMIONode::reset, py::arg("clock_config_file") = "", py::arg("warm_restart") = false)
     .def("soft_reset", &timing::SIMIONode::soft_reset)
     .def("read_firmware_frequency", &timing::SIMIONode::read_firmware_frequency)
     .def("get_clock_frequencies_table", &timing::SIMIONode::get_clock_frequencies_table, py::arg("print_out") = false)
@@ -112,10 +116,10 @@ register_io(py::module& m)
 
   py::class_<timing::MIBIONode, timing::IONode, uhal::Node>(m, "MIBIONode")
     .def(py::init<const uhal::Node&>())
-    .def<void (timing::MIBIONode::*)(const std::string&) const>(
-      "reset", &timing::MIBIONode::reset, py::arg("clock_config_file") = "")
-    .def<void (timing::MIBIONode::*)(int32_t, const std::string&) const>(
-      "reset", &timing::MIBIONode::reset, py::arg("fanout_mode"), py::arg("clock_config_file") = "")
+    .def<void (timing::MIBIONode::*)(const std::string&, bool) const>(
+      "reset", &timing::MIBIONode::reset, py::arg("clock_config_file") = "", py::arg("warm_restart") = false)
+    .def<void (timing::MIBIONode::*)(int32_t, const std::string&, bool) const>(
+      "reset", &timing::MIBIONode::reset, py::arg("fanout_mode"), py::arg("clock_config_file") = "", py::arg("warm_restart") = false)
     .def("soft_reset", &timing::MIBIONode::soft_reset)
     .def("read_firmware_frequency", &timing::MIBIONode::read_firmware_frequency)
     .def("get_clock_frequencies_table", &timing::MIBIONode::get_clock_frequencies_table, py::arg("print_out") = false)
@@ -22,6 +22,11 @@ namespace python {
 void
 register_master(py::module& m)
 {
+  py::class_<timing::TimestampSyncResult>(m, "TimestampSyncResult")
+    .def_readonly("round_trip_ns", &timing::TimestampSyncResult::round_trip_ns)
+    .def_readonly("residual_offset_ns", &timing::TimestampSyncResult::residual_offset_ns)
+    .def_readonly("frequency_error_ppm", &timing::TimestampSyncResult::frequency_error_ppm);
+
   py::class_<timing::PDIMasterNode, uhal::Node>(m, "PDIMasterNode")
     .def(py::init<const uhal::Node&>())
     .def<void (timing::PDIMasterNode::*)(uint32_t, uint32_t, uint32_t, uint32_t, bool, bool) // NOLINT(build/unsigned)
@@ -61,6 +66,13 @@ register_master(py::module& m)
     .def("get_status_with_date", &timing::PDIMasterNode::get_status_with_date, py::arg("clock_frequency_hz"), py::arg("print_out") = false)
     .def("sync_timestamp", &timing::PDIMasterNode::sync_timestamp);
 
+  py::class_<timing::FLCmdBurstResult>(m, "FLCmdBurstResult")
+    .def_readonly("sent", &timing::FLCmdBurstResult::sent)
+    .def_readonly("accepted", &timing::FLCmdBurstResult::accepted)
+    .def_readonly("rejected", &timing::FLCmdBurstResult::rejected)
+    .def_readonly("dropped", &timing::FLCmdBurstResult::dropped)
+    .def_readonly("rate_hz", &timing::FLCmdBurstResult::rate_hz);
+
   py::class_<timing::MasterNode, uhal::Node>(m, "MasterNode")
     .def(py::init<const uhal::Node&>())
     .def("switch_endpoint_sfp", &timing::MasterNode::switch_endpoint_sfp)
@@ -74,6 +86,12 @@ register_master(py::module& m)
          py::arg("command"),
          py::arg("channel"),
          py::arg("number_of_commands") = 1)
+    .def("send_fl_cmd_burst",
+         &timing::MasterNode::send_fl_cmd_burst,
+         py::arg("command"),
+         py::arg("channel"),
+         py::arg("number_of_commands"),
+         py::arg("log_sample_interval") = 0)
     .def<void (timing::MasterNode::*)(uint32_t, uint32_t, double, bool, uint32_t) const>("enable_periodic_fl_cmd",
          &timing::MasterNode::enable_periodic_fl_cmd,
          py::arg("command"),
@@ -7,7 +7,14 @@
  */
 
 #include "timing/toolbox.hpp"
+#include "timing/EndpointNode.hpp"
+#include "timing/EventDecoder.hpp"
+#include "timing/MasterNode.hpp"
+#include "timing/PDIEndpointNode.hpp"
+#include "timing/PDIMasterNode.hpp"
+#include "timing/TimestampExtrapolator.hpp"
 
+#include <pybind11/chrono.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -17,10 +24,87 @@ namespace dunedaq {
 namespace timing {
 namespace python {
 
+namespace {
+
+// the extrapolator reads the timestamp of a node it holds by reference; the node is kept alive by the binding
+template<class NODE>
+timing::TimestampExtrapolator*
+make_timestamp_extrapolator(const NODE& node,
+                            uint32_t clock_frequency_hz, // NOLINT(build/unsigned)
+                            std::chrono::milliseconds period,
+                            std::chrono::nanoseconds resync_threshold)
+{
+  return new timing::TimestampExtrapolator(
+    [&node]() { return node.read_timestamp(); }, clock_frequency_hz, period, resync_threshold);
+}
+
+template<class NODE>
+void
+add_timestamp_extrapolator_init(py::class_<timing::TimestampExtrapolator>& extrapolator)
+{
+  extrapolator.def(py::init(&make_timestamp_extrapolator<NODE>),
+                   py::keep_alive<1, 2>(),
+                   py::arg("node"),
+                   py::arg("clock_frequency_hz"),
+                   py::arg("period") = std::chrono::milliseconds(100),
+                   py::arg("resync_threshold") = std::chrono::nanoseconds(std::chrono::microseconds(10)));
+}
+
+} // namespace
+
 void
 register_toolbox(py::module& m)
 {
   m.def("format_firmware_version", &timing::format_firmware_version);	
+
+  py::class_<timing::EventDecodeResult>(m, "EventDecodeResult")
+    .def_readonly("n_events", &timing::EventDecodeResult::n_events)
+    .def_readonly("bad_headers", &timing::EventDecodeResult::bad_headers)
+    .def_readonly("sequence_gaps", &timing::EventDecodeResult::sequence_gaps)
+    .def_readonly("trailing_words", &timing::EventDecodeResult::trailing_words);
+
+  py::class_<timing::HSIEvents>(m, "HSIEvents")
+    .def(py::init<>())
+    .def("__len__", &timing::HSIEvents::size)
+    .def("clear", &timing::HSIEvents::clear)
+    .def_readonly("header", &timing::HSIEvents::header)
+    .def_readonly("timestamp", &timing::HSIEvents::timestamp)
+    .def_readonly("signal_map", &timing::HSIEvents::signal_map)
+    .def_readonly("sequence", &timing::HSIEvents::sequence);
+
+  py::class_<timing::PartitionEvents>(m, "PartitionEvents")
+    .def(py::init<>())
+    .def("__len__", &timing::PartitionEvents::size)
+    .def("clear", &timing::PartitionEvents::clear)
+    .def_readonly("header", &timing::PartitionEvents::header)
+    .def_readonly("command", &timing::PartitionEvents::command)
+    .def_readonly("timestamp", &timing::PartitionEvents::timestamp)
+    .def_readonly("event_counter", &timing::PartitionEvents::event_counter);
+
+  m.def("decode_hsi_events",
+        &timing::EventDecoder::decode_hsi_events<std::vector<uint32_t>>, // NOLINT(build/unsigned)
+        py::arg("words"),
+        py::arg("events"));
+  m.def("decode_partition_events",
+        &timing::EventDecoder::decode_partition_events<std::vector<uint32_t>>, // NOLINT(build/unsigned)
+        py::arg("words"),
+        py::arg("events"));
+
+  py::class_<timing::TimestampExtrapolator> extrapolator(m, "TimestampExtrapolator");
+  add_timestamp_extrapolator_init<timing::MasterNode>(extrapolator);
+  add_timestamp_extrapolator_init<timing::PDIMasterNode>(extrapolator);
+  add_timestamp_extrapolator_init<timing::EndpointNode>(extrapolator);
+  add_timestamp_extrapolator_init<timing::PDIEndpointNode>(extrapolator);
+  extrapolator.def("start", &timing::TimestampExtrapolator::start)
+    .def("stop", &timing::TimestampExtrapolator::stop)
+    .def("is_running", &timing::TimestampExtrapolator::is_running)
+    .def("resync", &timing::TimestampExtrapolator::resync)
+    .def("read_timestamp", &timing::TimestampExtrapolator::read_timestamp)
+    .def("read_timestamp_ns", &timing::TimestampExtrapolator::read_timestamp_ns)
+    .def("get_error_bound", &timing::TimestampExtrapolator::get_error_bound)
+    .def("get_fitted_frequency", &timing::TimestampExtrapolator::get_fitted_frequency)
+    .def("get_resync_count", &timing::TimestampExtrapolator::get_resync_count)
+    .def("get_status", &timing::TimestampExtrapolator::get_status, py::arg("print_out") = false);
 }
 
 } // namespace python
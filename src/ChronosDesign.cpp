@@ -56,17 +56,14 @@ ChronosDesign::configure() const
 void
 ChronosDesign::get_info(opmonlib::InfoCollector& ci, int level) const
 {  
-  opmonlib::InfoCollector hardware_collector;
-  get_io_node_plain()->get_info(hardware_collector, level);
-  ci.add("io", hardware_collector);
+  auto io_decoder = get_io_node_plain()->queue_info(level);
+  auto endpoint_decoder = get_endpoint_node_plain(0)->queue_info(level);
+  auto hsi_decoder = get_hsi_node().queue_info(level);
+  getClient().dispatch();
 
-  opmonlib::InfoCollector endpoint_collector;
-  get_endpoint_node_plain(0)->get_info(endpoint_collector, level);
-  ci.add("endpoint", endpoint_collector);
-
-  opmonlib::InfoCollector hsi_collector;
-  get_hsi_node().get_info(hsi_collector, level);
-  ci.add("hsi", hsi_collector);
+  decode_info(ci, "io", io_decoder);
+  decode_info(ci, "endpoint", endpoint_decoder);
+  decode_info(ci, "hsi", hsi_decoder);
 }
 //-----------------------------------------------------------------------------
 } // namespace dunedaq::timing
\ No newline at end of file
@@ -14,15 +14,23 @@
 
 #include <string>
 #include <chrono>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
 
 UHAL_REGISTER_DERIVED_NODE(EchoMonitorNode)
 
+const std::vector<std::string> EchoMonitorNode::kRegisterPaths = {
+  "csr.ctrl.go",
+  "csr.stat.rx_done",
+  "csr.stat.deltat",
+};
+
 //-----------------------------------------------------------------------------
 EchoMonitorNode::EchoMonitorNode(const uhal::Node& node)
   : TimingNode(node)
+  , m_registers(kRegisterPaths)
 {}
 //-----------------------------------------------------------------------------
 
@@ -48,18 +56,21 @@ uint64_t // NOLINT(build/unsigned)
 EchoMonitorNode::send_echo_and_measure_delay(int64_t timeout) const
 {
 
-  getNode("csr.ctrl.go").write(0x1);
+  m_registers.get(*this, kCtrlGo).write(0x1);
   getClient().dispatch();
 
   auto start = std::chrono::high_resolution_clock::now();
 
+  const uhal::Node& rx_done_node = m_registers.get(*this, kStatRxDone);
+  const uhal::Node& deltat_node = m_registers.get(*this, kStatDeltat);
+
   uhal::ValWord<uint32_t> done; // NOLINT(build/unsigned)
   uhal::ValWord<uint32_t> delta_t;
   
   while (true) {
 
-    done = getNode("csr.stat.rx_done").read();
-    delta_t = getNode("csr.stat.deltat").read();
+    done = rx_done_node.read();
+    delta_t = deltat_node.read();
     getClient().dispatch();
 
     TLOG_DEBUG(6) << "rx done: " << done.value() << ", delta_t: " << delta_t.value();
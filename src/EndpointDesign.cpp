@@ -59,13 +59,12 @@ EndpointDesign::configure() const
 void
 EndpointDesign::get_info(opmonlib::InfoCollector& ci, int level) const
 { 
-  opmonlib::InfoCollector endpoint_collector;
-  get_endpoint_node_plain(0)->get_info(endpoint_collector, level);
-  ci.add("endpoint", endpoint_collector);
+  auto endpoint_decoder = get_endpoint_node_plain(0)->queue_info(level);
+  auto io_decoder = get_io_node_plain()->queue_info(level);
+  getClient().dispatch();
 
-  opmonlib::InfoCollector hardware_collector;
-  get_io_node_plain()->get_info(hardware_collector, level);
-  ci.add("io", hardware_collector);
+  decode_info(ci, "endpoint", endpoint_decoder);
+  decode_info(ci, "io", io_decoder);
 }
 //-----------------------------------------------------------------------------
 
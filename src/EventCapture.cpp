@@ -0,0 +1,351 @@
+/**
+ * @file EventCapture.cpp
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/EventCapture.hpp"
+
+#include "timing/HSINode.hpp"
+#include "timing/PartitionNode.hpp"
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dunedaq {
+namespace timing {
+
+//-----------------------------------------------------------------------------
+const size_t EventCapture::kRecordsPerChunk = 4096;
+// large enough for the chunks to stay aligned on any page size
+const size_t EventCapture::kHeaderSize = 0x10000;
+const char EventCapture::kMagic[8] = { 'T', 'I', 'M', 'E', 'V', 'C', 'A', 'P' };
+const uint32_t EventCapture::kVersion = 1;             // NOLINT(build/unsigned)
+const uint32_t EventCapture::kIndexMagic = 0x58444e49; // NOLINT(build/unsigned) "INDX"
+const size_t EventCaptureWriter::kChunksPerExtent = 64;
+//-----------------------------------------------------------------------------
+
+static_assert(sizeof(EventCaptureIndexEntry) == sizeof(EventCaptureRecord), "index entries take one record slot");
+
+//-----------------------------------------------------------------------------
+size_t
+EventCapture::words_per_event(StreamType type)
+{
+  return type == kHSIStream ? HSINode::hsi_buffer_event_words_number : PartitionNode::kWordsPerEvent;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+uint64_t // NOLINT(build/unsigned)
+EventCapture::event_timestamp(StreamType type, const uint32_t* words) // NOLINT(build/unsigned)
+{
+  // HSI: header, ts low, ts high, ...; partition: header, command, ts low, ts high, ...
+  const uint32_t* timestamp = type == kHSIStream ? words + 1 : words + 2; // NOLINT(build/unsigned)
+  return static_cast<uint64_t>(timestamp[1]) << 32 | timestamp[0];       // NOLINT(build/unsigned)
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+size_t
+EventCapture::record_offset(uint64_t record) // NOLINT(build/unsigned)
+{
+  uint64_t chunk = record / (kRecordsPerChunk - 1); // NOLINT(build/unsigned)
+  uint64_t slot = record % (kRecordsPerChunk - 1);  // NOLINT(build/unsigned)
+  return kHeaderSize + chunk * chunk_size() + slot * sizeof(EventCaptureRecord);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+EventCaptureWriter::EventCaptureWriter(const std::string& path,
+                                       EventCapture::StreamType type,
+                                       uint64_t board_uid,          // NOLINT(build/unsigned)
+                                       uint32_t firmware_version,   // NOLINT(build/unsigned)
+                                       uint32_t clock_frequency_hz) // NOLINT(build/unsigned)
+  : m_path(path)
+  , m_type(type)
+  , m_fd(-1)
+  , m_header(nullptr)
+  , m_extent(nullptr)
+  , m_extent_offset(0)
+  , m_record_count(0)
+  , m_chunk_first_timestamp(0)
+{
+  m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (m_fd < 0)
+    throw EventCaptureError(ERS_HERE, path, std::strerror(errno));
+
+  void* header = MAP_FAILED;
+  if (ftruncate(m_fd, EventCapture::kHeaderSize) == 0)
+    header = mmap(nullptr, EventCapture::kHeaderSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (header == MAP_FAILED) {
+    std::string error = std::strerror(errno);
+    ::close(m_fd);
+    throw EventCaptureError(ERS_HERE, path, error);
+  }
+
+  m_header = static_cast<EventCaptureHeader*>(header);
+  std::memcpy(m_header->magic, EventCapture::kMagic, sizeof(EventCapture::kMagic));
+  m_header->version = EventCapture::kVersion;
+  m_header->stream_type = type;
+  m_header->words_per_event = EventCapture::words_per_event(type);
+  m_header->records_per_chunk = EventCapture::kRecordsPerChunk;
+  m_header->board_uid = board_uid;
+  m_header->firmware_version = firmware_version;
+  m_header->clock_frequency_hz = clock_frequency_hz;
+  m_header->start_time_ns =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+  m_header->record_count = 0;
+
+  try {
+    map_extent(EventCapture::kHeaderSize);
+  } catch (const EventCaptureError&) {
+    munmap(m_header, EventCapture::kHeaderSize);
+    ::close(m_fd);
+    throw;
+  }
+  TLOG_DEBUG(2) << "Opened event capture " << path;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+EventCaptureWriter::~EventCaptureWriter()
+{
+  try {
+    close();
+  } catch (const ers::Issue& e) {
+    ers::error(e);
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+EventCaptureWriter::append(const uint32_t* words, size_t n_events) // NOLINT(build/unsigned)
+{
+  if (m_fd < 0)
+    throw EventCaptureError(ERS_HERE, m_path, "append after close");
+
+  const size_t words_per_event = m_header->words_per_event;
+  const size_t extent_size = kChunksPerExtent * EventCapture::chunk_size();
+  const uint64_t records_per_chunk = EventCapture::kRecordsPerChunk - 1; // NOLINT(build/unsigned)
+
+  for (size_t i = 0; i < n_events; ++i, words += words_per_event) {
+    size_t offset = EventCapture::record_offset(m_record_count);
+    if (offset >= m_extent_offset + extent_size)
+      map_extent(m_extent_offset + extent_size);
+
+    EventCaptureRecord* record = reinterpret_cast<EventCaptureRecord*>(m_extent + (offset - m_extent_offset));
+    record->timestamp = EventCapture::event_timestamp(m_type, words);
+    std::memcpy(record->words, words, words_per_event * sizeof(uint32_t)); // NOLINT(build/unsigned)
+    std::fill(record->words + words_per_event, std::end(record->words), 0);
+
+    uint64_t slot = m_record_count % records_per_chunk; // NOLINT(build/unsigned)
+    if (slot == 0)
+      m_chunk_first_timestamp = record->timestamp;
+    if (slot == records_per_chunk - 1)
+      write_index_entry(m_record_count);
+
+    ++m_record_count;
+  }
+  m_header->record_count = m_record_count;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+EventCaptureWriter::close()
+{
+  if (m_fd < 0)
+    return;
+
+  const uint64_t records_per_chunk = EventCapture::kRecordsPerChunk - 1; // NOLINT(build/unsigned)
+  if (m_extent && m_record_count % records_per_chunk)
+    write_index_entry(m_record_count - 1);
+  m_header->record_count = m_record_count;
+
+  unmap_extent();
+  munmap(m_header, EventCapture::kHeaderSize);
+  m_header = nullptr;
+
+  // keep whole chunks, so that the last one has its index entry
+  uint64_t n_chunks = (m_record_count + records_per_chunk - 1) / records_per_chunk; // NOLINT(build/unsigned)
+  int status = ftruncate(m_fd, EventCapture::kHeaderSize + n_chunks * EventCapture::chunk_size());
+  std::string error = std::strerror(errno);
+  ::close(m_fd);
+  m_fd = -1;
+
+  if (status != 0)
+    throw EventCaptureError(ERS_HERE, m_path, error);
+  TLOG_DEBUG(2) << "Closed event capture " << m_path << ", " << m_record_count << " records";
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+EventCaptureWriter::map_extent(size_t offset)
+{
+  // the current extent stays mapped on failure, so that the writer can still be closed cleanly
+  const size_t extent_size = kChunksPerExtent * EventCapture::chunk_size();
+  void* extent = MAP_FAILED;
+  if (ftruncate(m_fd, offset + extent_size) == 0)
+    extent = mmap(nullptr, extent_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, offset);
+  if (extent == MAP_FAILED)
+    throw EventCaptureError(ERS_HERE, m_path, std::strerror(errno));
+
+  unmap_extent();
+  m_extent = static_cast<char*>(extent);
+  m_extent_offset = offset;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+EventCaptureWriter::unmap_extent()
+{
+  if (!m_extent)
+    return;
+
+  munmap(m_extent, kChunksPerExtent * EventCapture::chunk_size());
+  m_extent = nullptr;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+EventCaptureWriter::write_index_entry(uint64_t record) // NOLINT(build/unsigned)
+{
+  const uint64_t records_per_chunk = EventCapture::kRecordsPerChunk - 1; // NOLINT(build/unsigned)
+  uint64_t chunk = record / records_per_chunk;                           // NOLINT(build/unsigned)
+
+  // chunks never straddle extents, the entry is in the extent of its records
+  size_t offset = EventCapture::kHeaderSize + (chunk + 1) * EventCapture::chunk_size() - sizeof(EventCaptureRecord);
+  const EventCaptureRecord* last =
+    reinterpret_cast<const EventCaptureRecord*>(m_extent + (EventCapture::record_offset(record) - m_extent_offset));
+
+  EventCaptureIndexEntry* entry = reinterpret_cast<EventCaptureIndexEntry*>(m_extent + (offset - m_extent_offset));
+  entry->first_timestamp = m_chunk_first_timestamp;
+  entry->last_timestamp = last->timestamp;
+  entry->first_record = chunk * records_per_chunk;
+  entry->n_records = record % records_per_chunk + 1;
+  entry->magic = EventCapture::kIndexMagic;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+EventCaptureReader::EventCaptureReader(const std::string& path)
+  : m_path(path)
+  , m_data(nullptr)
+  , m_size(0)
+  , m_header(nullptr)
+  , m_record_count(0)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw EventCaptureError(ERS_HERE, path, std::strerror(errno));
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    std::string error = std::strerror(errno);
+    ::close(fd);
+    throw EventCaptureError(ERS_HERE, path, error);
+  }
+  if (static_cast<size_t>(file_stat.st_size) < EventCapture::kHeaderSize) {
+    ::close(fd);
+    throw EventCaptureError(ERS_HERE, path, "file shorter than the header");
+  }
+
+  m_size = file_stat.st_size;
+  void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED)
+    throw EventCaptureError(ERS_HERE, path, std::strerror(errno));
+
+  m_data = static_cast<const char*>(data);
+  m_header = reinterpret_cast<const EventCaptureHeader*>(m_data);
+
+  if (std::memcmp(m_header->magic, EventCapture::kMagic, sizeof(EventCapture::kMagic)) != 0 ||
+      m_header->version != EventCapture::kVersion || m_header->records_per_chunk != EventCapture::kRecordsPerChunk) {
+    munmap(const_cast<char*>(m_data), m_size);
+    throw EventCaptureError(ERS_HERE, path, "not an event capture file of version " + std::to_string(EventCapture::kVersion));
+  }
+
+  // a writer that did not close may leave the count ahead of the mapped extents, or the file shorter
+  uint64_t n_chunks = (m_size - EventCapture::kHeaderSize) / EventCapture::chunk_size(); // NOLINT(build/unsigned)
+  m_record_count = std::min<uint64_t>(m_header->record_count, n_chunks * (EventCapture::kRecordsPerChunk - 1)); // NOLINT(build/unsigned)
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+EventCaptureReader::~EventCaptureReader()
+{
+  munmap(const_cast<char*>(m_data), m_size);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+const EventCaptureRecord&
+EventCaptureReader::at(uint64_t record) const // NOLINT(build/unsigned)
+{
+  if (record >= m_record_count)
+    throw EventCaptureError(ERS_HERE, m_path, "record " + std::to_string(record) + " out of range");
+
+  return *reinterpret_cast<const EventCaptureRecord*>(m_data + EventCapture::record_offset(record));
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+uint64_t // NOLINT(build/unsigned)
+EventCaptureReader::seek(uint64_t timestamp) const // NOLINT(build/unsigned)
+{
+  const uint64_t records_per_chunk = EventCapture::kRecordsPerChunk - 1;           // NOLINT(build/unsigned)
+  const uint64_t n_chunks = (m_record_count + records_per_chunk - 1) / records_per_chunk; // NOLINT(build/unsigned)
+
+  // last timestamp of a chunk, from its index entry unless the writer did not get to write it
+  auto chunk_last_timestamp = [&](uint64_t chunk) { // NOLINT(build/unsigned)
+    const EventCaptureIndexEntry* entry = reinterpret_cast<const EventCaptureIndexEntry*>(
+      m_data + EventCapture::kHeaderSize + (chunk + 1) * EventCapture::chunk_size() - sizeof(EventCaptureRecord));
+    if (entry->magic == EventCapture::kIndexMagic && entry->first_record == chunk * records_per_chunk)
+      return entry->last_timestamp;
+    return at(std::min(m_record_count, (chunk + 1) * records_per_chunk) - 1).timestamp;
+  };
+
+  // first chunk ending at or after the timestamp
+  uint64_t low = 0, high = n_chunks; // NOLINT(build/unsigned)
+  while (low < high) {
+    uint64_t middle = low + (high - low) / 2; // NOLINT(build/unsigned)
+    if (chunk_last_timestamp(middle) < timestamp)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  if (low == n_chunks)
+    return m_record_count;
+
+  // then the first record of that chunk at or after it
+  uint64_t first = low * records_per_chunk;                                    // NOLINT(build/unsigned)
+  uint64_t last = std::min(m_record_count, first + records_per_chunk);         // NOLINT(build/unsigned)
+  while (first < last) {
+    uint64_t middle = first + (last - first) / 2; // NOLINT(build/unsigned)
+    if (at(middle).timestamp < timestamp)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  return first;
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
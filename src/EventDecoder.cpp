@@ -0,0 +1,150 @@
+/**
+ * @file EventDecoder.cpp
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/EventDecoder.hpp"
+
+#include "timing/HSINode.hpp"
+#include "timing/PartitionNode.hpp"
+
+namespace dunedaq {
+namespace timing {
+
+//-----------------------------------------------------------------------------
+const uint32_t EventDecoder::kEventHeader = 0xaa000600; // NOLINT(build/unsigned)
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+HSIEvents::reserve(size_t n_events)
+{
+  header.reserve(n_events);
+  timestamp.reserve(n_events);
+  signal_map.reserve(n_events);
+  sequence.reserve(n_events);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+HSIEvents::clear()
+{
+  header.clear();
+  timestamp.clear();
+  signal_map.clear();
+  sequence.clear();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+PartitionEvents::reserve(size_t n_events)
+{
+  header.reserve(n_events);
+  command.reserve(n_events);
+  timestamp.reserve(n_events);
+  event_counter.reserve(n_events);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+PartitionEvents::clear()
+{
+  header.clear();
+  command.clear();
+  timestamp.clear();
+  event_counter.clear();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+EventDecodeResult
+EventDecoder::decode_hsi_events(const uint32_t* words, size_t n_words, HSIEvents& events) // NOLINT(build/unsigned)
+{
+  const size_t stride = HSINode::hsi_buffer_event_words_number;
+  const size_t n_events = n_words / stride;
+  const size_t offset = events.size();
+
+  // the previous event of the stream, if any, seeds the sequence check
+  uint32_t previous = offset ? events.sequence.back() : 0; // NOLINT(build/unsigned)
+
+  events.header.resize(offset + n_events);
+  events.timestamp.resize(offset + n_events);
+  events.signal_map.resize(offset + n_events);
+  events.sequence.resize(offset + n_events);
+
+  uint32_t* __restrict header = events.header.data() + offset;         // NOLINT(build/unsigned)
+  uint64_t* __restrict timestamp = events.timestamp.data() + offset;   // NOLINT(build/unsigned)
+  uint32_t* __restrict signal_map = events.signal_map.data() + offset; // NOLINT(build/unsigned)
+  uint32_t* __restrict sequence = events.sequence.data() + offset;     // NOLINT(build/unsigned)
+
+  size_t bad_headers = 0;
+  size_t sequence_gaps = 0;
+  for (size_t i = 0; i < n_events; ++i) {
+    const uint32_t* event = words + i * stride; // NOLINT(build/unsigned)
+    header[i] = event[0];
+    timestamp[i] = static_cast<uint64_t>(event[2]) << 32 | event[1]; // NOLINT(build/unsigned)
+    signal_map[i] = event[3];
+    sequence[i] = event[4];
+
+    bad_headers += event[0] != kEventHeader;
+    sequence_gaps += event[4] != previous + 1;
+    previous = event[4];
+  }
+
+  // the first event of a stream has nothing to follow
+  if (!offset && n_events)
+    sequence_gaps -= sequence[0] != 1;
+
+  return { n_events, bad_headers, sequence_gaps, n_words - n_events * stride };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+EventDecodeResult
+EventDecoder::decode_partition_events(const uint32_t* words, size_t n_words, PartitionEvents& events) // NOLINT(build/unsigned)
+{
+  const size_t stride = PartitionNode::kWordsPerEvent;
+  const size_t n_events = n_words / stride;
+  const size_t offset = events.size();
+
+  uint32_t previous = offset ? events.event_counter.back() : 0; // NOLINT(build/unsigned)
+
+  events.header.resize(offset + n_events);
+  events.command.resize(offset + n_events);
+  events.timestamp.resize(offset + n_events);
+  events.event_counter.resize(offset + n_events);
+
+  uint32_t* __restrict header = events.header.data() + offset;               // NOLINT(build/unsigned)
+  uint32_t* __restrict command = events.command.data() + offset;             // NOLINT(build/unsigned)
+  uint64_t* __restrict timestamp = events.timestamp.data() + offset;         // NOLINT(build/unsigned)
+  uint32_t* __restrict event_counter = events.event_counter.data() + offset; // NOLINT(build/unsigned)
+
+  size_t bad_headers = 0;
+  size_t sequence_gaps = 0;
+  for (size_t i = 0; i < n_events; ++i) {
+    const uint32_t* event = words + i * stride; // NOLINT(build/unsigned)
+    header[i] = event[0];
+    command[i] = event[1];
+    timestamp[i] = static_cast<uint64_t>(event[3]) << 32 | event[2]; // NOLINT(build/unsigned)
+    event_counter[i] = event[4];
+
+    bad_headers += event[0] != kEventHeader;
+    sequence_gaps += event[4] != previous + 1;
+    previous = event[4];
+  }
+
+  if (!offset && n_events)
+    sequence_gaps -= event_counter[0] != 1;
+
+  return { n_events, bad_headers, sequence_gaps, n_words - n_events * stride };
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
@@ -27,6 +27,7 @@ FIBIONode::FIBIONode(const uhal::Node& aNode) :
 
 //-----------------------------------------------------------------------------
 FIBIONode::~FIBIONode() {
+  stop_i2c_info_sampler();
 }
 //-----------------------------------------------------------------------------
 
@@ -41,6 +42,7 @@ FIBIONode::get_uid_address_parameter_name() const
 //-----------------------------------------------------------------------------
 std::string
 FIBIONode::get_status(bool print_out) const {
+	std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 	std::stringstream status;
 	auto subnodes = read_sub_nodes(getNode("csr.stat"));
 
@@ -64,7 +66,8 @@ FIBIONode::get_status(bool print_out) const {
 
 //-----------------------------------------------------------------------------
 void
-FIBIONode::reset(int32_t fanout_mode, const std::string& clock_config_file) const {
+FIBIONode::reset(int32_t fanout_mode, const std::string& clock_config_file, bool warm_restart) const {
+	std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 	
 	// Soft reset
 	write_soft_reset_register();
@@ -76,6 +79,8 @@ FIBIONode::reset(int32_t fanout_mode, const std::string& clock_config_file) cons
 	getNode("csr.ctrl.rstb_i2c").write(0x0);
 	getClient().dispatch();
 
+	invalidate_i2c_core_states();
+
 	const CarrierType carrier_type = convert_value_to_carrier_type(read_carrier_type());
 
 	if (carrier_type == kCarrierEnclustraA35) {
@@ -91,39 +96,24 @@ FIBIONode::reset(int32_t fanout_mode, const std::string& clock_config_file) cons
 	auto ic_10 = get_i2c_device<I2CExpanderSlave>(m_uid_i2c_bus, "Expander1");
 	auto ic_23 = get_i2c_device<I2CExpanderSlave>(m_uid_i2c_bus, "Expander2");
 
-	// Bank 0
-	ic_10->set_inversion(0, 0x00);
-	
-	//  all out, sfp tx disable
-	ic_10->set_io(0, 0x00);
-	// sfp laser on by default
-	ic_10->set_outputs(0, 0x00);
-
-	// Bank 1
-	ic_10->set_inversion(1, 0x00);
-	// all inputs, sfp fault
-	ic_10->set_io(1, 0xff);
-
-	// Bank 0
-	ic_23->set_inversion(0, 0x00);
-	// pin 0 - out: pll rst, pins 1-4 pll and cdr flags
-	ic_23->set_io(0, 0xfe);
-	ic_23->set_outputs(0, 0x01);
+	// Bank 0: all out, sfp tx disable, sfp laser on by default
+	// Bank 1: all inputs, sfp fault
+	ic_10->configure({ 0x00, 0x00, 0x00 }, { 0x00, 0xff, 0xff });
 
-	// Bank 1
-	ic_23->set_inversion(1, 0x00);
-	// all inputs, sfp los
-	ic_23->set_io(1, 0xff);
+	// Bank 0: pin 0 - out: pll rst, pins 1-4 pll and cdr flags
+	// Bank 1: all inputs, sfp los
+	ic_23->configure({ 0x00, 0xfe, 0x01 }, { 0x00, 0xff, 0xff });
 
-	// reset pll via I2C IO expanders
-	reset_pll();
+	// reset pll via I2C IO expanders, unless it is kept running
+	if (!warm_restart)
+		reset_pll();
 	
 	// Find the right pll config file
 	std::string clock_config_path = get_full_clock_config_file_path(clock_config_file, fanout_mode);
 	TLOG() << "PLL configuration file : " << clock_config_path;
 
 	// Upload config file to PLL
-	configure_pll(clock_config_path);
+	configure_pll(clock_config_path, warm_restart);
 	
 	//getNode("csr.ctrl.inmux").write(0);
 	//getClient().dispatch();
@@ -140,8 +130,8 @@ FIBIONode::reset(int32_t fanout_mode, const std::string& clock_config_file) cons
 
 //-----------------------------------------------------------------------------
 void
-FIBIONode::reset(const std::string& clock_config_file) const {
-	reset(-1, clock_config_file);
+FIBIONode::reset(const std::string& clock_config_file, bool warm_restart) const {
+	reset(-1, clock_config_file, warm_restart);
 }
 //-----------------------------------------------------------------------------
 
@@ -170,6 +160,7 @@ FIBIONode::read_active_downstream_mux_channel() const {
 //-----------------------------------------------------------------------------
 std::string
 FIBIONode::get_sfp_status(uint32_t sfp_id, bool print_out) const { // NOLINT(build/unsigned)
+	std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 	std::stringstream status;
 	
 	validate_sfp_id(sfp_id);
@@ -190,6 +181,7 @@ FIBIONode::get_sfp_status(uint32_t sfp_id, bool print_out) const { // NOLINT(bui
 //-----------------------------------------------------------------------------
 void
 FIBIONode::switch_sfp_soft_tx_control_bit(uint32_t sfp_id, bool turn_on) const { // NOLINT(build/unsigned)
+	std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 	validate_sfp_id(sfp_id);
 
 	// on this board the 8 downstream sfps have their own i2c bus
@@ -203,6 +195,7 @@ FIBIONode::switch_sfp_soft_tx_control_bit(uint32_t sfp_id, bool turn_on) const {
 //-----------------------------------------------------------------------------
 void
 FIBIONode::reset_pll() const {
+	std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 	auto ic_23 = get_i2c_device<I2CExpanderSlave>(m_uid_i2c_bus, "Expander2");
 	ic_23->set_outputs(0, 0x00);
 	ic_23->set_outputs(0, 0x01);
@@ -212,6 +205,7 @@ FIBIONode::reset_pll() const {
 //-----------------------------------------------------------------------------
 uint8_t // NOLINT(build/unsigned)
 FIBIONode::read_sfp_los_flags() const {
+	std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 	auto ic_23 = get_i2c_device<I2CExpanderSlave>(m_uid_i2c_bus, "Expander2");
 
 	uint8_t sfp_los_flags = ic_23->read_inputs(0x01); // NOLINT(build/unsigned)
@@ -223,6 +217,7 @@ FIBIONode::read_sfp_los_flags() const {
 //-----------------------------------------------------------------------------
 uint8_t // NOLINT(build/unsigned)
 FIBIONode::read_sfp_fault_flags() const {
+	std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 	auto ic_10 = get_i2c_device<I2CExpanderSlave>(m_uid_i2c_bus, "Expander1");
 	
 	uint8_t sfp_fault_flags = ic_10->read_inputs(0x01); // NOLINT(build/unsigned)
@@ -249,22 +244,13 @@ FIBIONode::read_sfp_fault_flag(uint32_t sfp_id) const { // NOLINT(build/unsigned
 //-----------------------------------------------------------------------------
 void
 FIBIONode::switch_sfp_tx(uint32_t sfp_id, bool turn_on) const { // NOLINT(build/unsigned)
+	std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 	validate_sfp_id(sfp_id);
 	
 	auto ic_10 = get_i2c_device<I2CExpanderSlave>(m_uid_i2c_bus, "Expander1");
-	uint8_t current_sfp_tx_control_flags = ic_10->read_outputs_config(0); // NOLINT(build/unsigned)
 
-	uint8_t new_sfp_tx_control_flags; // NOLINT(build/unsigned)
-	if (turn_on) 
-	{
-		new_sfp_tx_control_flags = current_sfp_tx_control_flags & ~(1UL << sfp_id);
-	}
-    else 
-    {
-    	new_sfp_tx_control_flags = current_sfp_tx_control_flags | (1UL << sfp_id);
-    }
-
-    ic_10->set_outputs(0, new_sfp_tx_control_flags);
+	// tx disable is active high
+	ic_10->set_output_bit(0, sfp_id, !turn_on);
 }
 //-----------------------------------------------------------------------------
 
@@ -309,58 +295,104 @@ FIBIONode::get_clock_frequencies_table(bool print_out) const
 void
 FIBIONode::get_info(timinghardwareinfo::TimingFIBMonitorData& mon_data) const
 {
+  auto decoder = queue_monitor_data();
+  getClient().dispatch();
+  decoder(mon_data);
+}
+//-----------------------------------------------------------------------------
 
-  auto stat_subnodes = read_sub_nodes(getNode("csr.stat"));
-  auto ctrl_subnodes = read_sub_nodes(getNode("csr.ctrl"));
+//-----------------------------------------------------------------------------
+void
+FIBIONode::get_info(opmonlib::InfoCollector& ci, int level) const
+{
+  collect_info(ci, level);
+}
+//-----------------------------------------------------------------------------
 
-  mon_data.mmcm_ok = stat_subnodes.at("mmcm_ok").value();
-  mon_data.mmcm_sticky = stat_subnodes.at("mmcm_sticky").value();
-  
-  mon_data.pll_ok = stat_subnodes.at("pll_ok").value();
-  mon_data.pll_sticky = stat_subnodes.at("pll_sticky").value();
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+FIBIONode::queue_info(int level) const
+{
+  // the I2C data is read at decode time, or taken from the background sampler
+  InfoDecoder i2c_decoder;
+  if (level >= 2) {
+    i2c_decoder = queue_i2c_info(level);
+  }
 
-  mon_data.active_sfp_mux = ctrl_subnodes.at("inmux").value();
+  std::function<void(timinghardwareinfo::TimingFIBMonitorData&)> decoder;
+  if (level >= 1) {
+    decoder = queue_monitor_data();
+  }
 
-  //mon_data.sfp_los_flags = read_sfp_los_flags();
-  //mon_data.sfp_fault_flags = read_sfp_fault_flags();
+  return [i2c_decoder, decoder](opmonlib::InfoCollector& ci) {
+    if (i2c_decoder) {
+      i2c_decoder(ci);
+    }
+    if (decoder) {
+      timinghardwareinfo::TimingFIBMonitorData mon_data;
+      decoder(mon_data);
+      ci.add(mon_data);
+    }
+  };
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-void
-FIBIONode::get_info(opmonlib::InfoCollector& ci, int level) const
+std::function<void(timinghardwareinfo::TimingFIBMonitorData&)>
+FIBIONode::queue_monitor_data() const
 {
+  auto stat_subnodes = read_sub_nodes(getNode("csr.stat"), false);
+  auto ctrl_subnodes = read_sub_nodes(getNode("csr.ctrl"), false);
 
-  if (level >= 2) {
-    timinghardwareinfo::TimingPLLMonitorData pll_mon_data;
-    get_pll()->get_info(pll_mon_data);
-    ci.add(pll_mon_data);
+  return [=](timinghardwareinfo::TimingFIBMonitorData& mon_data) {
+    mon_data.mmcm_ok = stat_subnodes.at("mmcm_ok").value();
+    mon_data.mmcm_sticky = stat_subnodes.at("mmcm_sticky").value();
+
+    mon_data.pll_ok = stat_subnodes.at("pll_ok").value();
+    mon_data.pll_sticky = stat_subnodes.at("pll_sticky").value();
+
+    mon_data.active_sfp_mux = ctrl_subnodes.at("inmux").value();
+
+    //mon_data.sfp_los_flags = read_sfp_los_flags();
+    //mon_data.sfp_fault_flags = read_sfp_fault_flags();
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+FIBIONode::sample_i2c_info(int level) const
+{
+  timinghardwareinfo::TimingPLLMonitorData pll_mon_data;
+  get_pll()->get_info(pll_mon_data);
+
+  std::vector<std::pair<std::string, opmonlib::InfoCollector>> sfp_ics;
+  for (uint i=0; i < 8; ++i)
+  {
+    opmonlib::InfoCollector sfp_ic;
     
-    for (uint i=0; i < 8; ++i)
+    std::string sfp_i2c_bus = "i2c_sfp" + std::to_string(i);
+    auto sfp = get_i2c_device<I2CSFPSlave>(sfp_i2c_bus, "SFP_EEProm");
+          
+    try
     {
-      opmonlib::InfoCollector sfp_ic;
-      
-			std::string sfp_i2c_bus = "i2c_sfp" + std::to_string(i);
-			auto sfp = get_i2c_device<I2CSFPSlave>(sfp_i2c_bus, "SFP_EEProm");
-			      
-      try
-      {
-        sfp->get_info(sfp_ic, level);
-      }
-      catch (timing::SFPUnreachable& e)
-      {
-        // It is valid that an SFP may not be installed, currently no good way of knowing whether they it should be
-        TLOG_DEBUG(2) << "Failed to communicate with SFP " << i <<  " on I2C switch channel " << (1UL << i) << " on i2c bus" << m_sfp_i2c_buses.at(0);
-        continue;
-      }
-      ci.add("sfp_"+std::to_string(i),sfp_ic);
+      sfp->get_info(sfp_ic, level);
     }
+    catch (timing::SFPUnreachable& e)
+    {
+      // It is valid that an SFP may not be installed, currently no good way of knowing whether they it should be
+      TLOG_DEBUG(2) << "Failed to communicate with SFP " << i <<  " on I2C switch channel " << (1UL << i) << " on i2c bus" << m_sfp_i2c_buses.at(0);
+      continue;
+    }
+    sfp_ics.push_back(std::make_pair("sfp_"+std::to_string(i), sfp_ic));
   }
-  if (level >= 1) {
-    timinghardwareinfo::TimingFIBMonitorData mon_data;
-    this->get_info(mon_data);
-    ci.add(mon_data);
-  }
+
+  return [pll_mon_data, sfp_ics](opmonlib::InfoCollector& ci) {
+    ci.add(pll_mon_data);
+    for (auto sfp_ic : sfp_ics) {
+      ci.add(sfp_ic.first, sfp_ic.second);
+    }
+  };
 }
 //-----------------------------------------------------------------------------
 } // namespace timing
@@ -68,20 +68,57 @@ FLCmdGeneratorNode::validate_channel(uint32_t channel) const // NOLINT(build/uns
 void
 FLCmdGeneratorNode::send_fl_cmd(uint32_t command,       // NOLINT(build/unsigned)
                                 uint32_t channel) const // NOLINT(build/unsigned)
+{
+  select_fl_cmd(command, channel, false);
+
+  getNode("ctrl.force").write(0x1);
+  getClient().dispatch();
+
+  getNode("ctrl.force").write(0x0);
+  getClient().dispatch();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+FLCmdGeneratorNode::select_fl_cmd(uint32_t command, // NOLINT(build/unsigned)
+                                  uint32_t channel, // NOLINT(build/unsigned)
+                                  bool dispatch) const
 {
   validate_command(command);
   validate_channel(channel);
 
   getNode("sel").write(channel);
 
-  reset_sub_nodes(getNode("chan_ctrl"));
+  reset_sub_nodes(getNode("chan_ctrl"), 0x0, false);
 
   getNode("chan_ctrl.type").write(command);
-  getNode("ctrl.force").write(0x1);
-  getClient().dispatch();
+  if (dispatch)
+    getClient().dispatch();
+}
+//-----------------------------------------------------------------------------
 
-  getNode("ctrl.force").write(0x0);
-  getClient().dispatch();
+//-----------------------------------------------------------------------------
+void
+FLCmdGeneratorNode::queue_fl_cmd_pulses(uint32_t number_of_commands) const // NOLINT(build/unsigned)
+{
+  const uhal::Node& force = getNode("ctrl.force");
+  for (uint32_t i = 0; i < number_of_commands; ++i) { // NOLINT(build/unsigned)
+    force.write(0x1);
+    force.write(0x0);
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::pair<uhal::ValVector<uint32_t>, uhal::ValVector<uint32_t>> // NOLINT(build/unsigned)
+FLCmdGeneratorNode::read_counters(bool dispatch) const
+{
+  auto accepted_counters = getNode("actrs").readBlock(getNode("actrs").getSize());
+  auto rejected_counters = getNode("rctrs").readBlock(getNode("rctrs").getSize());
+  if (dispatch)
+    getClient().dispatch();
+  return std::make_pair(accepted_counters, rejected_counters);
 }
 //-----------------------------------------------------------------------------
 
@@ -161,7 +198,7 @@ FLCmdGeneratorNode::enable_periodic_fl_cmd(uint32_t command,  // NOLINT(build/un
   getNode("chan_ctrl.rate_div_p").write(prescale);
   getNode("chan_ctrl.patt").write(poisson);
   getNode("chan_ctrl.en").write(1); // Start the command stream
-  getClient().dispatch();
+  dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -203,27 +240,36 @@ FLCmdGeneratorNode::get_cmd_counters_table(bool print_out) const
 
 //-----------------------------------------------------------------------------
 void
-FLCmdGeneratorNode::get_info(opmonlib::InfoCollector& ic, int /*level*/) const
+FLCmdGeneratorNode::get_info(opmonlib::InfoCollector& ic, int level) const
+{
+  collect_info(ic, level);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+FLCmdGeneratorNode::queue_info(int /*level*/) const
 {
   auto accepted_counters = getNode("actrs").readBlock(getNode("actrs").getSize());
   auto rejected_counters = getNode("rctrs").readBlock(getNode("actrs").getSize());
-  getClient().dispatch();
 
-  uint number_of_channels = 5;
+  return [accepted_counters, rejected_counters](opmonlib::InfoCollector& ic) {
+    uint number_of_channels = 5;
 
-  for (uint i = 0; i < number_of_channels; ++i) { // NOLINT(build/unsigned)
+    for (uint i = 0; i < number_of_channels; ++i) { // NOLINT(build/unsigned)
 
-    timingfirmwareinfo::TimingFLCmdCounter cmd_counter;
-    opmonlib::InfoCollector cmd_counter_ic;
+      timingfirmwareinfo::TimingFLCmdCounter cmd_counter;
+      opmonlib::InfoCollector cmd_counter_ic;
 
-    cmd_counter.accepted = accepted_counters.at(i);
-    cmd_counter.rejected = rejected_counters.at(i);
+      cmd_counter.accepted = accepted_counters.at(i);
+      cmd_counter.rejected = rejected_counters.at(i);
 
-    std::string channel = "fl_cmd_channel_" + std::to_string(i);
+      std::string channel = "fl_cmd_channel_" + std::to_string(i);
 
-    cmd_counter_ic.add(cmd_counter);
-    ic.add(channel, cmd_counter_ic);
-  }
+      cmd_counter_ic.add(cmd_counter);
+      ic.add(channel, cmd_counter_ic);
+    }
+  };
 }
 //-----------------------------------------------------------------------------
 
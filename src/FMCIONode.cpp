@@ -23,7 +23,10 @@ FMCIONode::FMCIONode(const uhal::Node& node)
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-FMCIONode::~FMCIONode() {}
+FMCIONode::~FMCIONode()
+{
+  stop_i2c_info_sampler();
+}
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
@@ -57,17 +60,20 @@ FMCIONode::get_status(bool print_out) const
 
 //-----------------------------------------------------------------------------
 void
-FMCIONode::reset(const std::string& clock_config_file) const
+FMCIONode::reset(const std::string& clock_config_file, bool warm_restart) const
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 
   write_soft_reset_register();
 
   millisleep(1000);
 
-  // Reset PLL
-  getNode("csr.ctrl.pll_rst").write(0x1);
-  getNode("csr.ctrl.pll_rst").write(0x0);
-  getClient().dispatch();
+  // Reset PLL, unless it is kept running
+  if (!warm_restart) {
+    getNode("csr.ctrl.pll_rst").write(0x1);
+    getNode("csr.ctrl.pll_rst").write(0x0);
+    getClient().dispatch();
+  }
 
   CarrierType carrier_type = convert_value_to_carrier_type(read_carrier_type());
 
@@ -85,7 +91,7 @@ FMCIONode::reset(const std::string& clock_config_file) const
   TLOG() << "PLL configuration file : " << clock_config_path;
 
   // Upload config file to PLL
-  configure_pll(clock_config_path);
+  configure_pll(clock_config_path, warm_restart);
 
   // Reset mmcm
   getNode("csr.ctrl.rst").write(0x1);
@@ -122,9 +128,10 @@ FMCIONode::reset(const std::string& clock_config_file) const
 //-----------------------------------------------------------------------------
 void
 FMCIONode::reset(int32_t /*fanout_mode*/, // NOLINT(build/unsigned)
-                     const std::string& clock_config_file) const
+                     const std::string& clock_config_file,
+                     bool warm_restart) const
 {
-  reset(clock_config_file);
+  reset(clock_config_file, warm_restart);
 }
 //-----------------------------------------------------------------------------
 
@@ -173,15 +180,9 @@ FMCIONode::get_clock_frequencies_table(bool print_out) const
 void
 FMCIONode::get_info(timinghardwareinfo::TimingFMCMonitorData& mon_data) const
 {
-
-  auto subnodes = read_sub_nodes(getNode("csr.stat"));
-
-  mon_data.cdr_lol = subnodes.at("cdr_lol").value();
-  mon_data.cdr_los = subnodes.at("cdr_los").value();
-  mon_data.mmcm_ok = subnodes.at("mmcm_ok").value();
-  mon_data.mmcm_sticky = subnodes.at("mmcm_sticky").value();
-  mon_data.sfp_flt = subnodes.at("sfp_flt").value();
-  mon_data.sfp_los = subnodes.at("sfp_los").value();
+  auto decoder = queue_monitor_data();
+  getClient().dispatch();
+  decoder(mon_data);
 }
 //-----------------------------------------------------------------------------
 
@@ -189,26 +190,79 @@ FMCIONode::get_info(timinghardwareinfo::TimingFMCMonitorData& mon_data) const
 void
 FMCIONode::get_info(opmonlib::InfoCollector& ci, int level) const
 {
-  if (level >= 2) {
-    timinghardwareinfo::TimingPLLMonitorData pll_mon_data;
-    this->get_pll()->get_info(pll_mon_data);
-    ci.add(pll_mon_data);
+  collect_info(ci, level);
+}
+//-----------------------------------------------------------------------------
 
-    timinghardwareinfo::TimingSFPMonitorData sfp_mon_data;
-    auto sfp = this->get_i2c_device<I2CSFPSlave>(m_sfp_i2c_buses.at(0), "SFP_EEProm");
-    try {
-      sfp->get_info(sfp_mon_data);
-      ci.add(sfp_mon_data);
-    } catch (timing::SFPUnreachable& e) {
-      // It is valid that an SFP may not be installed, currently no good way of knowing whether they it should be
-      TLOG_DEBUG(2) << "Failed to communicate with SFP on i2c bus" << m_sfp_i2c_buses.at(0);
-    }
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+FMCIONode::queue_info(int level) const
+{
+  // the I2C data is read at decode time, or taken from the background sampler
+  InfoDecoder i2c_decoder;
+  if (level >= 2) {
+    i2c_decoder = queue_i2c_info(level);
   }
+
+  std::function<void(timinghardwareinfo::TimingFMCMonitorData&)> decoder;
   if (level >= 1) {
-    timinghardwareinfo::TimingFMCMonitorData mon_data;
-    this->get_info(mon_data);
-    ci.add(mon_data);
+    decoder = queue_monitor_data();
   }
+
+  return [i2c_decoder, decoder](opmonlib::InfoCollector& ci) {
+    if (i2c_decoder) {
+      i2c_decoder(ci);
+    }
+    if (decoder) {
+      timinghardwareinfo::TimingFMCMonitorData mon_data;
+      decoder(mon_data);
+      ci.add(mon_data);
+    }
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::function<void(timinghardwareinfo::TimingFMCMonitorData&)>
+FMCIONode::queue_monitor_data() const
+{
+  auto subnodes = read_sub_nodes(getNode("csr.stat"), false);
+
+  return [=](timinghardwareinfo::TimingFMCMonitorData& mon_data) {
+    mon_data.cdr_lol = subnodes.at("cdr_lol").value();
+    mon_data.cdr_los = subnodes.at("cdr_los").value();
+    mon_data.mmcm_ok = subnodes.at("mmcm_ok").value();
+    mon_data.mmcm_sticky = subnodes.at("mmcm_sticky").value();
+    mon_data.sfp_flt = subnodes.at("sfp_flt").value();
+    mon_data.sfp_los = subnodes.at("sfp_los").value();
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+FMCIONode::sample_i2c_info(int /*level*/) const
+{
+  timinghardwareinfo::TimingPLLMonitorData pll_mon_data;
+  this->get_pll()->get_info(pll_mon_data);
+
+  timinghardwareinfo::TimingSFPMonitorData sfp_mon_data;
+  bool sfp_reachable = false;
+  auto sfp = this->get_i2c_device<I2CSFPSlave>(m_sfp_i2c_buses.at(0), "SFP_EEProm");
+  try {
+    sfp->get_info(sfp_mon_data);
+    sfp_reachable = true;
+  } catch (timing::SFPUnreachable& e) {
+    // It is valid that an SFP may not be installed, currently no good way of knowing whether they it should be
+    TLOG_DEBUG(2) << "Failed to communicate with SFP on i2c bus" << m_sfp_i2c_buses.at(0);
+  }
+
+  return [pll_mon_data, sfp_mon_data, sfp_reachable](opmonlib::InfoCollector& ci) {
+    ci.add(pll_mon_data);
+    if (sfp_reachable) {
+      ci.add(sfp_mon_data);
+    }
+  };
 }
 //-----------------------------------------------------------------------------
 } // namespace timing
@@ -55,9 +55,9 @@ FanoutDesign::configure() const
 
 //-----------------------------------------------------------------------------
 void
-FanoutDesign::reset_io(int32_t fanout_mode, const std::string& clock_config_file) const
+FanoutDesign::reset_io(int32_t fanout_mode, const std::string& clock_config_file, bool warm_restart) const
 {
-  get_io_node_plain()->reset(fanout_mode, clock_config_file);
+  get_io_node_plain()->reset(fanout_mode, clock_config_file, warm_restart);
   // 0 - fanout mode, outgoing data comes from sfp
   // 1 - standalone mode, outgoing data comes from local master
   if (fanout_mode < 0) {
@@ -121,17 +121,14 @@ FanoutDesign::apply_endpoint_delay(uint32_t address,
 void
 FanoutDesign::get_info(opmonlib::InfoCollector& ci, int level) const
 { 
-  opmonlib::InfoCollector master_collector;
-  this->get_master_node_plain()->get_info(master_collector, level);
-  ci.add("master", master_collector);
-
-  opmonlib::InfoCollector hardware_collector;
-  this->get_io_node_plain()->get_info(hardware_collector, level);
-  ci.add("io", hardware_collector);
-
-  opmonlib::InfoCollector endpoint_collector;
-  get_endpoint_node_plain(0)->get_info(endpoint_collector, level);
-  ci.add("endpoint", endpoint_collector);
+  auto master_decoder = this->get_master_node_plain()->queue_info(level);
+  auto io_decoder = this->get_io_node_plain()->queue_info(level);
+  auto endpoint_decoder = get_endpoint_node_plain(0)->queue_info(level);
+  getClient().dispatch();
+
+  decode_info(ci, "master", master_decoder);
+  decode_info(ci, "io", io_decoder);
+  decode_info(ci, "endpoint", endpoint_decoder);
 }
 //-----------------------------------------------------------------------------
 
@@ -111,11 +111,11 @@ HSINode::read_data_buffer(uint16_t& n_words, bool read_all, bool fail_on_error)
   }
 
   // this is bad
-  if (n_hsi_words > 1024) {
+  if (n_hsi_words > hsi_buffer_words_number) {
     ers::error(HSIBufferIssue(ERS_HERE, "OVERFLOW"));
     if (fail_on_error)
       return buffer_data;
-    n_hsi_words = 1024;
+    n_hsi_words = hsi_buffer_words_number;
   }
 
   uint32_t events_to_read = n_hsi_words / hsi_buffer_event_words_number; // NOLINT(build/unsigned)
@@ -219,7 +219,7 @@ HSINode::configure_hsi(uint32_t src,      // NOLINT(build/unsigned)
   }
 
   if (dispatch)
-    getClient().dispatch();
+    dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -229,7 +229,7 @@ HSINode::start_hsi(bool dispatch) const
 {
   getNode("csr.ctrl.en").write(0x1);
   if (dispatch)
-    getClient().dispatch();
+    dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -239,7 +239,7 @@ HSINode::stop_hsi(bool dispatch) const
 {
   getNode("csr.ctrl.en").write(0x0);
   if (dispatch)
-    getClient().dispatch();
+    dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -258,7 +258,7 @@ HSINode::reset_hsi(bool dispatch) const
   getNode("csr.ctrl.src").write(0x0);
 
   if (dispatch)
-    getClient().dispatch();
+    dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -286,17 +286,27 @@ HSINode::read_buffer_error() const
 uint32_t // NOLINT(build/unsigned)
 HSINode::read_buffer_state() const
 {
+  auto buffer_state = queue_buffer_state();
+  getClient().dispatch();
+  return buffer_state();
+}
+//-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+std::function<uint32_t()> // NOLINT(build/unsigned)
+HSINode::queue_buffer_state() const
+{
   auto buf_state = read_sub_nodes(getNode("csr.stat"), false);
   auto hsi_buffer_count = getNode("buf.count").read();
-  getClient().dispatch();
 
-  uint8_t buffer_error = static_cast<uint8_t>(buf_state.find("buf_err")->second.value());    // NOLINT(build/unsigned)
-  uint8_t buffer_warning = static_cast<uint8_t>(buf_state.find("buf_warn")->second.value()); // NOLINT(build/unsigned)
+  return [=]() {
+    uint8_t buffer_error = static_cast<uint8_t>(buf_state.find("buf_err")->second.value());    // NOLINT(build/unsigned)
+    uint8_t buffer_warning = static_cast<uint8_t>(buf_state.find("buf_warn")->second.value()); // NOLINT(build/unsigned)
 
-  uint32_t buffer_state = buffer_error | (buffer_warning << 1);                          // NOLINT(build/unsigned)
-  buffer_state = buffer_state | static_cast<uint32_t>(hsi_buffer_count.value()) << 0x10; // NOLINT(build/unsigned)
-  return buffer_state;
+    uint32_t buffer_state = buffer_error | (buffer_warning << 1);                          // NOLINT(build/unsigned)
+    buffer_state = buffer_state | static_cast<uint32_t>(hsi_buffer_count.value()) << 0x10; // NOLINT(build/unsigned)
+    return buffer_state;
+  };
 }
 //-----------------------------------------------------------------------------
 
@@ -313,6 +323,37 @@ HSINode::read_signal_source_mode() const
 //-----------------------------------------------------------------------------
 void
 HSINode::get_info(timingfirmwareinfo::HSIFirmwareMonitorData& mon_data) const
+{
+  auto decoder = queue_monitor_data();
+  getClient().dispatch();
+  decoder(mon_data);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+HSINode::get_info(opmonlib::InfoCollector& ci, int level) const
+{
+  collect_info(ci, level);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+HSINode::queue_info(int /*level*/) const
+{
+  auto decoder = queue_monitor_data();
+  return [decoder](opmonlib::InfoCollector& ci) {
+    timingfirmwareinfo::HSIFirmwareMonitorData mon_data;
+    decoder(mon_data);
+    ci.add(mon_data);
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::function<void(timingfirmwareinfo::HSIFirmwareMonitorData&)>
+HSINode::queue_monitor_data() const
 {
   auto hsi_control = read_sub_nodes(getNode("csr.ctrl"), false);
   auto hsi_state = read_sub_nodes(getNode("csr.stat"), false);
@@ -323,27 +364,17 @@ HSINode::get_info(timingfirmwareinfo::HSIFirmwareMonitorData& mon_data) const
   auto hsi_fe_mask = getNode("csr.fe_mask").read();
   auto hsi_inv_mask = getNode("csr.inv_mask").read();
 
-  getClient().dispatch();
-
-  mon_data.source = hsi_control.find("src")->second.value();
-  mon_data.re_mask = hsi_re_mask.value();
-  mon_data.fe_mask = hsi_fe_mask.value();
-  mon_data.inv_mask = hsi_inv_mask.value();
-  mon_data.buffer_enabled = hsi_control.find("buf_en")->second.value();
-  mon_data.buffer_error = hsi_state.find("buf_err")->second.value();
-  mon_data.buffer_warning = hsi_state.find("buf_warn")->second.value();
-  mon_data.buffer_occupancy = hsi_buffer_count.value();
-  mon_data.enabled = hsi_control.find("en")->second.value();
-}
-//-----------------------------------------------------------------------------
-
-//-----------------------------------------------------------------------------
-void
-HSINode::get_info(opmonlib::InfoCollector& ci, int /*level*/) const
-{
-  timingfirmwareinfo::HSIFirmwareMonitorData mon_data;
-  this->get_info(mon_data);
-  ci.add(mon_data);
+  return [=](timingfirmwareinfo::HSIFirmwareMonitorData& mon_data) {
+    mon_data.source = hsi_control.find("src")->second.value();
+    mon_data.re_mask = hsi_re_mask.value();
+    mon_data.fe_mask = hsi_fe_mask.value();
+    mon_data.inv_mask = hsi_inv_mask.value();
+    mon_data.buffer_enabled = hsi_control.find("buf_en")->second.value();
+    mon_data.buffer_error = hsi_state.find("buf_err")->second.value();
+    mon_data.buffer_warning = hsi_state.find("buf_warn")->second.value();
+    mon_data.buffer_occupancy = hsi_buffer_count.value();
+    mon_data.enabled = hsi_control.find("en")->second.value();
+  };
 }
 //-----------------------------------------------------------------------------
 } // namespace timing
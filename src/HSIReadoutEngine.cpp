@@ -0,0 +1,304 @@
+/**
+ * @file HSIReadoutEngine.cpp
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/HSIReadoutEngine.hpp"
+
+#include "timing/TimingIssues.hpp"
+#include "timing/toolbox.hpp"
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+//-----------------------------------------------------------------------------
+const size_t HSIReadoutEngine::kDefaultCapacity = 1 << 16;
+const double HSIReadoutEngine::kTargetOccupancy = 0.25;
+//-----------------------------------------------------------------------------
+
+namespace {
+size_t
+round_up_to_power_of_two(size_t n)
+{
+  size_t power = 1;
+  while (power < n)
+    power <<= 1;
+  return power;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+HSIReadoutEngine::HSIReadoutEngine(const HSINode& hsi_node,
+                                   size_t capacity,
+                                   std::chrono::microseconds min_interval,
+                                   std::chrono::microseconds max_interval)
+  : m_hsi_node(hsi_node)
+  , m_capacity(round_up_to_power_of_two(std::max<size_t>(capacity, 1)))
+  , m_min_interval(min_interval)
+  , m_max_interval(std::max(min_interval, max_interval))
+  , m_capture_writer(nullptr)
+  , m_ring(m_capacity * HSINode::hsi_buffer_event_words_number)
+  , m_write_index(0)
+  , m_read_index(0)
+  , m_stop(true)
+  , m_poll_count(0)
+  , m_ring_full_count(0)
+  , m_buffer_warnings(0)
+  , m_buffer_errors(0)
+  , m_interval_ns(m_max_interval.count())
+{}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+HSIReadoutEngine::~HSIReadoutEngine()
+{
+  stop();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+HSIReadoutEngine::set_capture_writer(EventCaptureWriter* writer)
+{
+  if (writer && writer->get_stream_type() != EventCapture::kHSIStream)
+    throw EventCaptureError(ERS_HERE, writer->get_path(), "not an HSI capture");
+
+  if (is_running())
+    throw EventCaptureError(ERS_HERE, writer ? writer->get_path() : "", "cannot change capture while the HSI readout runs");
+
+  m_capture_writer = writer;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+HSIReadoutEngine::start()
+{
+  stop();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stop = false;
+  m_thread = std::thread(&HSIReadoutEngine::run, this);
+  TLOG_DEBUG(2) << "Started HSI readout, ring capacity: " << m_capacity << " events";
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+HSIReadoutEngine::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_stop_condition.notify_all();
+
+  if (m_thread.joinable()) {
+    m_thread.join();
+    TLOG_DEBUG(2) << "Stopped HSI readout";
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+bool
+HSIReadoutEngine::is_running() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return !m_stop;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::array<HSIReadoutEngine::EventSpan, 2>
+HSIReadoutEngine::peek() const
+{
+  uint64_t read_index = m_read_index.load(std::memory_order_relaxed);   // NOLINT(build/unsigned)
+  uint64_t write_index = m_write_index.load(std::memory_order_acquire); // NOLINT(build/unsigned)
+
+  size_t available = write_index - read_index;
+  size_t first = read_index & (m_capacity - 1);
+  size_t first_events = std::min(available, m_capacity - first);
+
+  const uint32_t* ring = m_ring.data(); // NOLINT(build/unsigned)
+  return { { { ring + first * HSINode::hsi_buffer_event_words_number, first_events },
+             { ring, available - first_events } } };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+HSIReadoutEngine::release(size_t n_events)
+{
+  uint64_t read_index = m_read_index.load(std::memory_order_relaxed);   // NOLINT(build/unsigned)
+  uint64_t write_index = m_write_index.load(std::memory_order_acquire); // NOLINT(build/unsigned)
+
+  n_events = std::min<uint64_t>(n_events, write_index - read_index); // NOLINT(build/unsigned)
+  m_read_index.store(read_index + n_events, std::memory_order_release);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+size_t
+HSIReadoutEngine::get_available_events() const
+{
+  return m_write_index.load(std::memory_order_acquire) - m_read_index.load(std::memory_order_acquire);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+uint64_t // NOLINT(build/unsigned)
+HSIReadoutEngine::get_event_count() const
+{
+  return m_write_index.load(std::memory_order_acquire);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::string
+HSIReadoutEngine::get_status(bool print_out) const
+{
+  std::vector<std::pair<std::string, std::string>> summary;
+  summary.push_back(std::make_pair("Running", std::to_string(is_running())));
+  summary.push_back(std::make_pair("Events read", std::to_string(get_event_count())));
+  summary.push_back(std::make_pair("Events in ring", std::to_string(get_available_events())));
+  summary.push_back(std::make_pair("Ring capacity", std::to_string(m_capacity)));
+  summary.push_back(std::make_pair("Polls", std::to_string(m_poll_count.load())));
+  summary.push_back(std::make_pair("Polls with full ring", std::to_string(m_ring_full_count.load())));
+  summary.push_back(std::make_pair("Buffer warnings", std::to_string(m_buffer_warnings.load())));
+  summary.push_back(std::make_pair("Buffer errors", std::to_string(m_buffer_errors.load())));
+  summary.push_back(std::make_pair("Poll interval [us]", std::to_string(m_interval_ns.load() / 1000)));
+
+  std::stringstream status;
+  status << format_reg_table(summary, "HSI readout", { "", "" });
+
+  if (print_out)
+    TLOG() << status.str();
+  return status.str();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::chrono::nanoseconds
+HSIReadoutEngine::next_interval(uint32_t buffer_state, double words_per_ns) const // NOLINT(build/unsigned)
+{
+  double target_words = kTargetOccupancy * HSINode::hsi_buffer_words_number;
+
+  // flags raised or already past the target: drain as fast as allowed
+  if ((buffer_state & 0x3) || (buffer_state >> 0x10) > target_words)
+    return m_min_interval;
+
+  if (words_per_ns <= 0.)
+    return m_max_interval;
+
+  auto interval = std::chrono::nanoseconds(static_cast<int64_t>(target_words / words_per_ns));
+  return std::clamp(interval, m_min_interval, m_max_interval);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+HSIReadoutEngine::run()
+{
+  const size_t event_words = HSINode::hsi_buffer_event_words_number;
+
+  uint32_t previous_flags = 0;            // NOLINT(build/unsigned)
+  uint32_t words_left = 0;                // NOLINT(build/unsigned)
+  double words_per_ns = 0.;
+  auto previous_poll = std::chrono::steady_clock::now();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stop) {
+    lock.unlock();
+
+    std::chrono::nanoseconds interval = m_max_interval;
+    try {
+      // fresh state after the wait, so that the poll drains everything that arrived meanwhile
+      auto buffer_state = m_hsi_node.queue_buffer_state();
+      m_hsi_node.getClient().dispatch();
+      auto now = std::chrono::steady_clock::now();
+
+      uint32_t state = buffer_state(); // NOLINT(build/unsigned)
+      uint32_t words = std::min<uint32_t>(state >> 0x10, HSINode::hsi_buffer_words_number); // NOLINT(build/unsigned)
+      uint32_t flags = state & 0x3;                                                          // NOLINT(build/unsigned)
+
+      // only report the flags when raised, not on every poll while they stay up
+      if ((flags & 0x2) && !(previous_flags & 0x2)) {
+        ++m_buffer_warnings;
+        ers::warning(HSIBufferIssue(ERS_HERE, "WARNING"));
+      }
+      if ((flags & 0x1) && !(previous_flags & 0x1)) {
+        ++m_buffer_errors;
+        ers::error(HSIBufferIssue(ERS_HERE, "ERROR"));
+      }
+      previous_flags = flags;
+
+      // arrival rate since the state left by the previous poll, smoothed
+      double elapsed_ns = std::chrono::duration<double, std::nano>(now - previous_poll).count();
+      if (elapsed_ns > 0. && words >= words_left)
+        words_per_ns = 0.5 * words_per_ns + 0.5 * (words - words_left) / elapsed_ns;
+
+      uint64_t write_index = m_write_index.load(std::memory_order_relaxed);                    // NOLINT(build/unsigned)
+      size_t free_events = m_capacity - (write_index - m_read_index.load(std::memory_order_acquire));
+      size_t n_events = std::min<size_t>(words / event_words, free_events);
+      if (n_events < words / event_words)
+        ++m_ring_full_count;
+
+      uhal::ValVector<uint32_t> data; // NOLINT(build/unsigned)
+      if (n_events)
+        data = m_hsi_node.getNode("buf.data").readBlock(n_events * event_words);
+      // the state after draining comes back in the same packet as the events
+      auto drained_buffer_state = m_hsi_node.queue_buffer_state();
+      m_hsi_node.getClient().dispatch();
+      previous_poll = std::chrono::steady_clock::now();
+      ++m_poll_count;
+
+      if (n_events) {
+        size_t first = write_index & (m_capacity - 1);
+        size_t first_events = std::min(n_events, m_capacity - first);
+        std::copy(data.begin(), data.begin() + first_events * event_words, m_ring.begin() + first * event_words);
+        std::copy(data.begin() + first_events * event_words, data.end(), m_ring.begin());
+        m_write_index.store(write_index + n_events, std::memory_order_release);
+
+        // a capture failure must not stop the readout
+        if (m_capture_writer) {
+          try {
+            m_capture_writer->append(&*data.begin(), n_events);
+          } catch (const ers::Issue& e) {
+            ers::error(e);
+            m_capture_writer = nullptr;
+          }
+        }
+      }
+      uint32_t drained_state = drained_buffer_state(); // NOLINT(build/unsigned)
+      words_left = std::min<uint32_t>(drained_state >> 0x10, HSINode::hsi_buffer_words_number); // NOLINT(build/unsigned)
+
+      interval = next_interval(drained_state, words_per_ns);
+    } catch (const std::exception& e) {
+      ers::warning(HSIReadoutFailed(ERS_HERE, e));
+      words_left = 0;
+      words_per_ns = 0.;
+      previous_poll = std::chrono::steady_clock::now();
+    }
+    m_interval_ns = interval.count();
+
+    lock.lock();
+    m_stop_condition.wait_for(lock, interval, [this] { return m_stop; });
+  }
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
@@ -12,6 +12,10 @@
 #include "ers/ers.hpp"
 #include "timing/toolbox.hpp"
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 // #include <fstream>
 // #include <sstream>
@@ -19,9 +23,13 @@
 namespace dunedaq {
 namespace timing {
 
+std::map<I2C9546SwitchSlave::CacheKey_t, uint8_t> I2C9546SwitchSlave::s_channels_states; // NOLINT(build/unsigned)
+std::mutex I2C9546SwitchSlave::s_channels_states_mutex;
+
 //-----------------------------------------------------------------------------
 I2C9546SwitchSlave::I2C9546SwitchSlave(const I2CMasterNode* i2c_master, uint8_t address) // NOLINT(build/unsigned)
   : I2CSlave(i2c_master, address)
+  , m_cache_key(i2c_master->get_device_id(), address)
 {}
 //-----------------------------------------------------------------------------
 
@@ -46,9 +54,11 @@ void
 I2C9546SwitchSlave::enable_channel(uint8_t channel) const // NOLINT(build/unsigned)
 {
   this->ensure_valid_channel(channel);
-  std::vector<uint8_t> enable_byte = this->read_i2cPrimitive(1); // NOLINT(build/unsigned)
-  uint8_t new_enable_byte = enable_byte.at(0) | (1UL << channel); // NOLINT(build/unsigned)
-  this->write_i2cPrimitive({new_enable_byte});
+  uint8_t enable_byte; // NOLINT(build/unsigned)
+  if (!this->get_cached_channels_states(enable_byte)) {
+    enable_byte = this->read_channels_states();
+  }
+  this->select_channels(enable_byte | (1UL << channel));
 }
 //-----------------------------------------------------------------------------
 
@@ -57,9 +67,11 @@ void
 I2C9546SwitchSlave::disable_channel(uint8_t channel) const // NOLINT(build/unsigned)
 {
   this->ensure_valid_channel(channel);
-  std::vector<uint8_t> enable_byte = this->read_i2cPrimitive(1); // NOLINT(build/unsigned)
-  uint8_t new_enable_byte = enable_byte.at(0) & ~(1UL << channel); // NOLINT(build/unsigned)
-  this->write_i2cPrimitive({new_enable_byte});
+  uint8_t enable_byte; // NOLINT(build/unsigned)
+  if (!this->get_cached_channels_states(enable_byte)) {
+    enable_byte = this->read_channels_states();
+  }
+  this->select_channels(enable_byte & ~(1UL << channel));
 }
 //-----------------------------------------------------------------------------
 
@@ -68,6 +80,7 @@ uint8_t                                               // NOLINT(build/unsigned)
 I2C9546SwitchSlave::read_channels_states() const
 {
   std::vector<uint8_t> enable_byte = this->read_i2cPrimitive(1); // NOLINT(build/unsigned)
+  this->update_cache(enable_byte.at(0));
   return enable_byte.at(0);
 }
 //-----------------------------------------------------------------------------
@@ -76,7 +89,90 @@ I2C9546SwitchSlave::read_channels_states() const
 void                                                         // NOLINT(build/unsigned)
 I2C9546SwitchSlave::set_channels_states(uint8_t channels) const // NOLINT(build/unsigned)
 { 
-  this->write_i2cPrimitive({channels});
+  try {
+    this->write_i2cPrimitive({channels});
+  } catch (...) {
+    // the switch may or may not have taken the new state
+    this->invalidate_channels_states();
+    throw;
+  }
+  this->update_cache(channels);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+bool
+I2C9546SwitchSlave::select_channels(uint8_t channels, bool force) const // NOLINT(build/unsigned)
+{
+  uint8_t current_channels; // NOLINT(build/unsigned)
+  if (!force && this->get_cached_channels_states(current_channels) && current_channels == channels) {
+    return false;
+  }
+  this->set_channels_states(channels);
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+bool
+I2C9546SwitchSlave::get_cached_channels_states(uint8_t& channels) const // NOLINT(build/unsigned)
+{
+  std::lock_guard<std::mutex> lock(s_channels_states_mutex);
+  auto it = s_channels_states.find(m_cache_key);
+  if (it == s_channels_states.end()) {
+    return false;
+  }
+  channels = it->second;
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::vector<uint8_t>                                                        // NOLINT(build/unsigned)
+I2C9546SwitchSlave::order_sweep(const std::vector<uint8_t>& channels) const // NOLINT(build/unsigned)
+{
+  std::vector<uint8_t> ordered_channels(channels); // NOLINT(build/unsigned)
+
+  uint8_t current_channels; // NOLINT(build/unsigned)
+  if (this->get_cached_channels_states(current_channels)) {
+    auto it = std::find_if(ordered_channels.begin(), ordered_channels.end(), [current_channels](uint8_t channel) { // NOLINT(build/unsigned)
+      return current_channels == (1UL << channel);
+    });
+    if (it != ordered_channels.end()) {
+      std::rotate(ordered_channels.begin(), it, ordered_channels.end());
+    }
+  }
+  return ordered_channels;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2C9546SwitchSlave::invalidate_channels_states() const
+{
+  std::lock_guard<std::mutex> lock(s_channels_states_mutex);
+  s_channels_states.erase(m_cache_key);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2C9546SwitchSlave::drop_device_channels_states(const std::string& device_id)
+{
+  std::lock_guard<std::mutex> lock(s_channels_states_mutex);
+  auto it = s_channels_states.lower_bound(CacheKey_t(device_id, 0));
+  while (it != s_channels_states.end() && it->first.first == device_id) {
+    it = s_channels_states.erase(it);
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2C9546SwitchSlave::update_cache(uint8_t channels) const // NOLINT(build/unsigned)
+{
+  std::lock_guard<std::mutex> lock(s_channels_states_mutex);
+  s_channels_states[m_cache_key] = channels;
 }
 //-----------------------------------------------------------------------------
 
@@ -14,6 +14,9 @@
 
 // #include <boost/tuple/tuple.hpp>
 
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 // #include <fstream>
 // #include <sstream>
@@ -21,9 +24,19 @@
 namespace dunedaq {
 namespace timing {
 
+// Register pairs of the xx9535 expander: the register pointer toggles between
+// the two banks of a pair, so a pair can be written or read in one transaction
+const uint8_t I2CExpanderSlave::kOutputsRegister = 0x2;   // NOLINT(build/unsigned)
+const uint8_t I2CExpanderSlave::kInversionRegister = 0x4; // NOLINT(build/unsigned)
+const uint8_t I2CExpanderSlave::kIORegister = 0x6;        // NOLINT(build/unsigned)
+
+std::map<I2CExpanderSlave::ShadowKey_t, I2CExpanderSlave::ShadowRegisters> I2CExpanderSlave::s_shadows;
+std::mutex I2CExpanderSlave::s_shadows_mutex;
+
 //-----------------------------------------------------------------------------
 I2CExpanderSlave::I2CExpanderSlave(const I2CMasterNode* i2c_master, uint8_t address) // NOLINT(build/unsigned)
   : I2CSlave(i2c_master, address)
+  , m_shadow_key(i2c_master->get_device_id(), address)
 {}
 //-----------------------------------------------------------------------------
 
@@ -48,7 +61,7 @@ I2CExpanderSlave::set_inversion(uint8_t bank_id, uint32_t inversion_mask) const
 {
 
   this->ensure_valid_bank_id(bank_id);
-  this->write_i2c(0x4 + bank_id, inversion_mask);
+  this->write_register(kInversionRegister + bank_id, inversion_mask);
 }
 //-----------------------------------------------------------------------------
 
@@ -58,7 +71,7 @@ I2CExpanderSlave::set_io(uint8_t bank_id, uint32_t io_mask) const // NOLINT(buil
 {
 
   this->ensure_valid_bank_id(bank_id);
-  this->write_i2c(0x6 + bank_id, io_mask);
+  this->write_register(kIORegister + bank_id, io_mask);
 }
 //-----------------------------------------------------------------------------
 
@@ -68,7 +81,7 @@ I2CExpanderSlave::set_outputs(uint8_t bank_id, uint32_t output_values) const //
 {
 
   this->ensure_valid_bank_id(bank_id);
-  this->write_i2c(0x2 + bank_id, output_values);
+  this->write_register(kOutputsRegister + bank_id, output_values);
 }
 //-----------------------------------------------------------------------------
 
@@ -87,11 +100,151 @@ uint8_t                                                        // NOLINT(build/u
 I2CExpanderSlave::read_outputs_config(uint8_t bank_id) const { // NOLINT(build/unsigned)
 
     this->ensure_valid_bank_id(bank_id);
-    return this->read_i2c(0x2 + bank_id);
+    return this->read_register(kOutputsRegister + bank_id);
     
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+void
+I2CExpanderSlave::configure(const BankConfig& bank_0, const BankConfig& bank_1) const
+{
+  // Outputs before io, so that pins turned into outputs drive the new values straight away
+  this->write_register_pair(kInversionRegister, bank_0.inversion, bank_1.inversion);
+  this->write_register_pair(kOutputsRegister, bank_0.outputs, bank_1.outputs);
+  this->write_register_pair(kIORegister, bank_0.io, bank_1.io);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CExpanderSlave::set_output_bit(uint8_t bank_id, uint8_t bit, bool value, bool resync) const // NOLINT(build/unsigned)
+{
+  this->ensure_valid_bank_id(bank_id);
+
+  uint8_t address = kOutputsRegister + bank_id; // NOLINT(build/unsigned)
+  uint8_t outputs;                              // NOLINT(build/unsigned)
+
+  if (resync || !this->get_shadow(address, outputs)) {
+    outputs = this->read_register(address);
+  }
+
+  uint8_t new_outputs = value ? (outputs | (1UL << bit)) : (outputs & ~(1UL << bit)); // NOLINT(build/unsigned)
+  this->write_register(address, new_outputs);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CExpanderSlave::resync() const
+{
+  for (uint8_t address : { kOutputsRegister, kInversionRegister, kIORegister }) { // NOLINT(build/unsigned)
+    std::vector<uint8_t> values = this->read_i2cArray(address, 2); // NOLINT(build/unsigned)
+    this->update_shadow(address, values.at(0));
+    this->update_shadow(address + 1, values.at(1));
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CExpanderSlave::invalidate_shadow() const
+{
+  std::lock_guard<std::mutex> lock(s_shadows_mutex);
+  s_shadows.erase(m_shadow_key);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CExpanderSlave::drop_device_shadows(const std::string& device_id)
+{
+  std::lock_guard<std::mutex> lock(s_shadows_mutex);
+  auto it = s_shadows.lower_bound(ShadowKey_t(device_id, 0));
+  while (it != s_shadows.end() && it->first.first == device_id) {
+    it = s_shadows.erase(it);
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CExpanderSlave::write_register(uint8_t address, uint8_t value) const // NOLINT(build/unsigned)
+{
+  try {
+    this->write_i2c(address, value);
+  } catch (...) {
+    // the register may or may not have been written
+    this->invalidate_shadow(address);
+    throw;
+  }
+  this->update_shadow(address, value);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CExpanderSlave::write_register_pair(uint8_t address, uint8_t value_0, uint8_t value_1) const // NOLINT(build/unsigned)
+{
+  try {
+    this->write_i2cArray(address, { value_0, value_1 });
+  } catch (...) {
+    this->invalidate_shadow(address);
+    this->invalidate_shadow(address + 1);
+    throw;
+  }
+  this->update_shadow(address, value_0);
+  this->update_shadow(address + 1, value_1);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+uint8_t                                                // NOLINT(build/unsigned)
+I2CExpanderSlave::read_register(uint8_t address) const // NOLINT(build/unsigned)
+{
+  uint8_t value = this->read_i2c(address); // NOLINT(build/unsigned)
+  this->update_shadow(address, value);
+  return value;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CExpanderSlave::update_shadow(uint8_t address, uint8_t value) const // NOLINT(build/unsigned)
+{
+  std::lock_guard<std::mutex> lock(s_shadows_mutex);
+  ShadowRegisters& shadow = s_shadows[m_shadow_key];
+  shadow.values[address] = value;
+  shadow.valid[address] = true;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CExpanderSlave::invalidate_shadow(uint8_t address) const // NOLINT(build/unsigned)
+{
+  std::lock_guard<std::mutex> lock(s_shadows_mutex);
+  auto it = s_shadows.find(m_shadow_key);
+  if (it != s_shadows.end()) {
+    it->second.valid[address] = false;
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+bool
+I2CExpanderSlave::get_shadow(uint8_t address, uint8_t& value) const // NOLINT(build/unsigned)
+{
+  std::lock_guard<std::mutex> lock(s_shadows_mutex);
+  auto it = s_shadows.find(m_shadow_key);
+  if (it == s_shadows.end() || !it->second.valid[address]) {
+    return false;
+  }
+  value = it->second.values[address];
+  return true;
+}
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 std::vector<uint32_t> // NOLINT(build/unsigned)
 I2CExpanderSlave::debug() const
@@ -0,0 +1,138 @@
+/**
+ * @file I2CInfoSampler.cpp
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/I2CInfoSampler.hpp"
+
+#include "timing/TimingIssues.hpp"
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include <utility>
+
+namespace dunedaq {
+namespace timing {
+
+//-----------------------------------------------------------------------------
+I2CInfoSampler::I2CInfoSampler()
+  : m_stop(true)
+  , m_sample_count(0)
+  , m_failed_sample_count(0)
+{}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+I2CInfoSampler::I2CInfoSampler(const I2CInfoSampler& /*other*/)
+  : I2CInfoSampler()
+{}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+I2CInfoSampler::~I2CInfoSampler()
+{
+  stop();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CInfoSampler::start(SampleFunction sample, std::chrono::milliseconds period)
+{
+  stop();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stop = false;
+  m_thread = std::thread(&I2CInfoSampler::run, this, std::move(sample), period);
+  TLOG_DEBUG(2) << "Started I2C monitoring sampler, period: " << period.count() << " ms";
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CInfoSampler::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_stop_condition.notify_all();
+
+  if (m_thread.joinable()) {
+    m_thread.join();
+    TLOG_DEBUG(2) << "Stopped I2C monitoring sampler";
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+bool
+I2CInfoSampler::is_running() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return !m_stop;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+bool
+I2CInfoSampler::get_info(opmonlib::InfoCollector& ci) const
+{
+  timinghardwareinfo::TimingI2CSampleInfo sample_info;
+  TimingNode::InfoDecoder sample;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    sample = m_sample;
+    sample_info.sampler_running = !m_stop;
+    sample_info.sample_count = m_sample_count;
+    sample_info.failed_sample_count = m_failed_sample_count;
+    if (sample) {
+      sample_info.sample_age_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_sample_time).count();
+    }
+  }
+
+  // the decoder only replays sampled values, no need to hold the lock
+  if (sample)
+    sample(ci);
+
+  ci.add(sample_info);
+  return static_cast<bool>(sample);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CInfoSampler::run(SampleFunction sample, std::chrono::milliseconds period)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stop) {
+    lock.unlock();
+
+    TimingNode::InfoDecoder decoder;
+    try {
+      decoder = sample();
+    } catch (const std::exception& e) {
+      ers::warning(I2CInfoSampleFailed(ERS_HERE, e));
+    }
+
+    lock.lock();
+    if (decoder) {
+      m_sample = decoder;
+      m_sample_time = std::chrono::steady_clock::now();
+      ++m_sample_count;
+    } else {
+      ++m_failed_sample_count;
+    }
+
+    m_stop_condition.wait_for(lock, period, [this] { return m_stop; });
+  }
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
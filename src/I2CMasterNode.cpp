@@ -14,6 +14,8 @@
 #include "timing/I2CMasterNode.hpp"
 
 #include "ers/ers.hpp"
+#include "timing/I2C9546SwitchNode.hpp"
+#include "timing/I2CExpanderNode.hpp"
 #include "timing/I2CSlave.hpp"
 #include "timing/TimingIssues.hpp"
 #include "timing/toolbox.hpp"
@@ -23,7 +25,9 @@
 #include <boost/range/algorithm/copy.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -55,6 +59,12 @@ const uint8_t I2CMasterNode::kArbitrationLostBit = 0x20; // arblost = 0x1 << 5
 const uint8_t I2CMasterNode::kInProgressBit = 0x2;       // inprogress = 0x1 << 1 // NOLINT(build/unsigned)
 const uint8_t I2CMasterNode::kInterruptBit = 0x1;        // interrupt = 0x1       // NOLINT(build/unsigned)
 
+const double I2CMasterNode::kCoreClockFrequency = 31.25e6;
+const uint32_t I2CMasterNode::kClocksPerByte = 10; // NOLINT(build/unsigned)
+const double I2CMasterNode::kByteTransferTimeMargin = 1.5;
+const uint32_t I2CMasterNode::kCompletionTimeoutBytes = 32; // NOLINT(build/unsigned)
+const uint32_t I2CMasterNode::kCompletionPollsPerByte = 4;  // NOLINT(build/unsigned)
+
 //-----------------------------------------------------------------------------
 I2CMasterNode::I2CMasterNode(const uhal::Node& node)
   : uhal::Node(node)
@@ -82,6 +92,8 @@ I2CMasterNode::constructor()
   m_clock_prescale = 0x40;
   // m_clock_prescale = 0x100;
 
+  m_core_initialised = false;
+
   // Build the list of slaves
   // Loop over node parameters. Each parameter becomes a slave node.
   const std::unordered_map<std::string, std::string>& parameters = this->getParameters();
@@ -97,6 +109,12 @@ I2CMasterNode::constructor()
 //-----------------------------------------------------------------------------
 I2CMasterNode::~I2CMasterNode()
 {
+  // a later tree may reuse the device id: its devices must not inherit cached state
+  if (!m_device_id.empty()) {
+    I2CExpanderSlave::drop_device_shadows(m_device_id);
+    I2C9546SwitchSlave::drop_device_channels_states(m_device_id);
+  }
+
   std::unordered_map<std::string, I2CSlave*>::iterator it;
   for (it = m_i2c_devices.begin(); it != m_i2c_devices.end(); ++it) {
     // Delete slaves
@@ -105,6 +123,15 @@ I2CMasterNode::~I2CMasterNode()
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+const std::string&
+I2CMasterNode::get_device_id() const
+{
+  std::call_once(m_device_id_flag, [this]() { m_device_id = getClient().uri() + "/" + getPath(); });
+  return m_device_id;
+}
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 std::vector<std::string>
 I2CMasterNode::get_slaves() const
@@ -242,19 +269,56 @@ I2CMasterNode::write_block_i2c(uint8_t i2c_device_address,         // NOLINT(bui
   // bit 2:1: Reserved
   // bit 0: Interrupt acknowledge. When set, clears a pending interrupt
 
-  // Reset bus before beginning
-  reset();
+  // Reset bus before beginning, unless already done
+  ensure_core_initialised();
 
-  // Open the connection and send the slave address, bit 0 set to zero
-  send_i2c_command_and_write_data(kStartCmd, (i2c_device_address << 1) & 0xfe);
+  // The core has no command queue: each byte has to be on the bus before the next command is issued.
+  // Rather than polling each byte separately, the status read of byte N is queued in the same packet
+  // as the data and command of byte N+1, once the nominal byte time has elapsed.
+  // The status of byte N is checked after the dispatch.
+  const uhal::Node& tx_node = getNode(kTxNode);
+  const uhal::Node& cmd_node = getNode(kCmdNode);
+  const uhal::Node& status_node = getNode(kStatusNode);
 
+  // Slave address first, bit 0 set to zero, then the payload
+  std::vector<std::pair<uint8_t, uint8_t>> transfers; // NOLINT(build/unsigned)
+  transfers.reserve(data.size() + 1);
+  transfers.push_back(std::make_pair(kStartCmd | kWriteToSlaveCmd, (i2c_device_address << 1) & 0xfe));
   for (unsigned ibyte = 0; ibyte < data.size(); ibyte++) {
-
     // Send stop if last element of the array (and not vetoed)
     uint8_t cmd = (((ibyte == data.size() - 1) && send_stop) ? kStopCmd : 0x0); // NOLINT(build/unsigned)
+    transfers.push_back(std::make_pair(cmd | kWriteToSlaveCmd, data[ibyte]));
+  }
 
-    // Push the byte on the bus
-    send_i2c_command_and_write_data(cmd, data[ibyte]);
+  std::chrono::steady_clock::time_point issue_time;
+  try {
+    for (size_t i(0); i < transfers.size(); ++i) {
+
+      TLOG_DEBUG(10) << ">> queuing write cmd  = " << format_reg_value((uint32_t)transfers[i].first) // NOLINT(build/unsigned)
+                     << " data = " << format_reg_value((uint32_t)transfers[i].second);              // NOLINT(build/unsigned)
+
+      uhal::ValWord<uint32_t> previous_status; // NOLINT(build/unsigned)
+      if (i > 0) {
+        wait_for_byte_transfer(issue_time);
+        previous_status = status_node.read();
+      }
+
+      // Push the payload and the command on the bus
+      tx_node.write(transfers[i].second);
+      cmd_node.write(transfers[i].first);
+      getClient().dispatch();
+      issue_time = std::chrono::steady_clock::now();
+
+      if (i > 0) {
+        check_transfer_status(previous_status.value(), true, false);
+      }
+    }
+
+    // Wait for the last byte to finish. Require idle bus at the end if stop bit is high
+    wait_until_finished(issue_time, true, send_stop);
+  } catch (const timing::I2CException&) {
+    abort_transfer(issue_time);
+    throw;
   }
 }
 //-----------------------------------------------------------------------------
@@ -278,20 +342,63 @@ I2CMasterNode::read_block_i2c(uint8_t i2c_device_address, uint32_t number_of_byt
   // bit 2:1: Reserved
   // bit 0:   Interrupt acknowledge. When set, clears a pending interrupt
 
-  // Reset bus before beginning
-  reset();
+  // Reset bus before beginning, unless already done
+  ensure_core_initialised();
+
+  const uhal::Node& tx_node = getNode(kTxNode);
+  const uhal::Node& rx_node = getNode(kRxNode);
+  const uhal::Node& cmd_node = getNode(kCmdNode);
+  const uhal::Node& status_node = getNode(kStatusNode);
 
   // Open the connection & send the target i2c address. Bit 0 set to 1 (read)
-  send_i2c_command_and_write_data(kStartCmd, (i2c_device_address << 1) | 0x01);
+  tx_node.write((i2c_device_address << 1) | 0x01);
+  cmd_node.write(kStartCmd | kWriteToSlaveCmd);
+  getClient().dispatch();
+  auto issue_time = std::chrono::steady_clock::now();
 
   std::vector<uint8_t> lArray; // NOLINT(build/unsigned)
-  for (unsigned ibyte = 0; ibyte < number_of_bytes; ibyte++) {
+  lArray.reserve(number_of_bytes);
 
-    uint8_t cmd = ((ibyte == number_of_bytes - 1) ? (kStopCmd | kAckCmd) : 0x0); // NOLINT(build/unsigned)
+  try {
+    // As for writes, the status (and received data) of byte N are read back in the same packet
+    // that issues the command for byte N+1.
+    for (unsigned ibyte = 0; ibyte < number_of_bytes; ibyte++) {
+
+      uint8_t cmd = ((ibyte == number_of_bytes - 1) ? (kStopCmd | kAckCmd) : 0x0); // NOLINT(build/unsigned)
+      TLOG_DEBUG(10) << ">> queuing read cmd  = " << format_reg_value((uint32_t)(cmd | kReadFromSlaveCmd)); // NOLINT(build/unsigned)
+
+      wait_for_byte_transfer(issue_time);
+      uhal::ValWord<uint32_t> previous_status = status_node.read(); // NOLINT(build/unsigned)
+      uhal::ValWord<uint32_t> previous_data;                        // NOLINT(build/unsigned)
+      if (ibyte > 0) {
+        previous_data = rx_node.read();
+      }
+      cmd_node.write(cmd | kReadFromSlaveCmd);
+      getClient().dispatch();
+      issue_time = std::chrono::steady_clock::now();
+
+      // Only the address byte requires an acknowledgement from the slave
+      check_transfer_status(previous_status.value(), ibyte == 0, false);
+      if (ibyte > 0) {
+        TLOG_DEBUG(10) << "<< receive data      = " << format_reg_value((uint32_t)previous_data.value()); // NOLINT(build/unsigned)
+        lArray.push_back(previous_data.value() & 0xff);
+      }
+    }
 
-    // Push the cmd on the bus, retrieve the result and put it in the arrary
-    lArray.push_back(send_i2c_command_and_read_data(cmd));
+    if (number_of_bytes == 0) {
+      wait_until_finished(issue_time, true, false);
+      return lArray;
+    }
+
+    // Wait for the last byte, it comes with the final status read.
+    uint8_t result = wait_until_finished(issue_time, false, true);                      // NOLINT(build/unsigned)
+    TLOG_DEBUG(10) << "<< receive data      = " << format_reg_value((uint32_t)result); // NOLINT(build/unsigned)
+    lArray.push_back(result);
+  } catch (const timing::I2CException&) {
+    abort_transfer(issue_time);
+    throw;
   }
+
   return lArray;
 }
 //-----------------------------------------------------------------------------
@@ -300,8 +407,8 @@ I2CMasterNode::read_block_i2c(uint8_t i2c_device_address, uint32_t number_of_byt
 bool
 I2CMasterNode::ping(uint8_t i2c_device_address) const // NOLINT(build/unsigned)
 {
-  // Reset bus before beginning
-  reset();
+  // Reset bus before beginning, unless already done
+  ensure_core_initialised();
 
   try {
     send_i2c_command_and_write_data(kStartCmd, (i2c_device_address << 1) | 0x01);
@@ -320,8 +427,8 @@ I2CMasterNode::scan() const
 
   std::vector<uint8_t> address_vector; // NOLINT(build/unsigned)
 
-  // Reset bus before beginning
-  reset();
+  // Reset bus before beginning, unless already done
+  ensure_core_initialised();
 
   for (uint8_t iaddr(0); iaddr < 0x7f; ++iaddr) { // NOLINT(build/unsigned)
     // Open the connection & send the target i2c address. Bit 0 set to 1 (read)
@@ -352,6 +459,8 @@ I2CMasterNode::reset() const
   //        3) Enables the I2C core
   //        4) Sets all writable bus-master registers to default values
 
+  m_core_initialised = false;
+
   auto ctrl = getNode(kCtrlNode).read();
   auto pre_hi = getNode(kPreHiNode).read();
   auto pre_lo = getNode(kPreLoNode).read();
@@ -384,6 +493,26 @@ I2CMasterNode::reset() const
     getNode(kCmdNode).write(0x00);
     getClient().dispatch();
   }
+
+  m_core_initialised = true;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CMasterNode::invalidate_core_state() const
+{
+  m_core_initialised = false;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CMasterNode::ensure_core_initialised() const
+{
+  if (!m_core_initialised) {
+    reset();
+  }
 }
 //-----------------------------------------------------------------------------
 
@@ -400,17 +529,15 @@ I2CMasterNode::send_i2c_command_and_read_data(uint8_t command) const // NOLINT(b
   // Force the read bit high and set them cmd bits
   getNode(kCmdNode).write(full_cmd);
   getClient().dispatch();
+  auto issue_time = std::chrono::steady_clock::now();
 
   // Wait for transaction to finish. Require idle bus at the end if stop bit is high)
-  wait_until_finished(/*req ack*/ false, command & kStopCmd);
-
-  // Pull the data out of the rx register.
-  uhal::ValWord<uint32_t> result = getNode(kRxNode).read(); // NOLINT(build/unsigned)
-  getClient().dispatch();
+  // The data comes out of the rx register with the final status.
+  uint8_t result = wait_until_finished(issue_time, /*req ack*/ false, command & kStopCmd); // NOLINT(build/unsigned)
 
   TLOG_DEBUG(10) << "<< receive data      = " << format_reg_value((uint32_t)result); // NOLINT(build/unsigned)v
 
-  return (result & 0xff);
+  return result;
 }
 //-----------------------------------------------------------------------------
 
@@ -437,16 +564,19 @@ I2CMasterNode::send_i2c_command_and_write_data(uint8_t command, uint8_t data) co
 
   // Run the commands and wait for transaction to finish
   getClient().dispatch();
+  auto issue_time = std::chrono::steady_clock::now();
 
   // Wait for transaction to finish. Require idle bus at the end if stop bit is high
-  // wait_until_finished(req_hack, requ_idle)
-  wait_until_finished( true, command & kStopCmd); // NOLINT
+  // wait_until_finished(issue_time, req_hack, requ_idle)
+  wait_until_finished(issue_time, true, command & kStopCmd); // NOLINT
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-void
-I2CMasterNode::wait_until_finished(bool require_acknowledgement, bool require_bus_idle_at_end) const
+uint8_t // NOLINT(build/unsigned)
+I2CMasterNode::wait_until_finished(const std::chrono::steady_clock::time_point& issue_time,
+                                   bool require_acknowledgement,
+                                   bool require_bus_idle_at_end) const
 {
   // Ensures the current bus transaction has finished successfully
   // before allowing further I2C bus transactions
@@ -454,43 +584,104 @@ I2CMasterNode::wait_until_finished(bool require_acknowledgement, bool require_bu
   // and will not allow execution to continue until the
   // I2C bus has completed properly.  It will throw an exception
   // if it picks up bus problems or a bus timeout occurs.
-  const unsigned max_retry = 20;
-  unsigned attempt = 1;
-  bool received_acknowledge, busy;
+  //
+  // The first status read goes out once a byte time (derived from the clock prescale) has elapsed
+  // since the command was issued, when the transfer is expected to be over. Later polls are spaced by
+  // a fraction of the byte time. The transfer only times out if a status read issued after the
+  // deadline (in bus time) still sees it in progress, so a slow host does not cause spurious timeouts.
+  const std::chrono::nanoseconds byte_time = get_byte_transfer_time();
+  const std::chrono::steady_clock::time_point deadline = issue_time + byte_time * kCompletionTimeoutBytes;
 
   const uhal::Node& status_node = getNode(kStatusNode);
+  const uhal::Node& rx_node = getNode(kRxNode);
+
+  std::this_thread::sleep_until(issue_time + byte_time);
+
+  while (true) {
+    auto poll_time = std::chrono::steady_clock::now();
 
-  while (attempt <= max_retry) {
-    usleep(10);
-    // Get the status
+    // Get the status, and the received data along with it
     uhal::ValWord<uint32_t> i2c_status = status_node.read(); // NOLINT(build/unsigned)
+    uhal::ValWord<uint32_t> rx_data = rx_node.read();        // NOLINT(build/unsigned)
     getClient().dispatch();
 
-    received_acknowledge = !(i2c_status & kReceivedAckBit);
-    busy = (i2c_status & kBusyBit);
     bool arbitration_lost = (i2c_status & kArbitrationLostBit);
     bool transfer_in_progress = (i2c_status & kInProgressBit);
 
-    if (arbitration_lost) {
-      // This is an instant error at any time
-      throw I2CBusArbitrationLost(ERS_HERE, getId());
+    if (arbitration_lost || !transfer_in_progress) {
+      // The transfer looks to have completed, check how it went
+      check_transfer_status(i2c_status.value(), require_acknowledgement, require_bus_idle_at_end);
+      return (rx_data & 0xff);
     }
 
-    if (!transfer_in_progress) {
-      // The transfer looks to have completed successfully,
-      // pending further checks
-      break;
+    if (poll_time > deadline) {
+      invalidate_core_state();
+      throw I2CTransactionTimeout(ERS_HERE, getId());
     }
 
-    attempt += 1;
+    std::this_thread::sleep_for(byte_time / kCompletionPollsPerByte);
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::chrono::nanoseconds
+I2CMasterNode::get_byte_transfer_time() const
+{
+  // SCL period = 5 * (prescale + 1) core clock cycles
+  double scl_period = 5. * (m_clock_prescale + 1) / kCoreClockFrequency;
+  double byte_time = scl_period * kClocksPerByte * kByteTransferTimeMargin;
+  return std::chrono::nanoseconds(static_cast<int64_t>(byte_time * 1e9));
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CMasterNode::wait_for_byte_transfer(const std::chrono::steady_clock::time_point& issue_time) const
+{
+  // The dispatch round trip usually covers most of the byte time already
+  std::this_thread::sleep_until(issue_time + get_byte_transfer_time());
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CMasterNode::abort_transfer(const std::chrono::steady_clock::time_point& issue_time) const
+{
+  // With pipelined transfers, the command of the next byte may already be running when an error shows up.
+  // Let it complete, then release the bus with a stop. Whatever happens, the next transaction starts from
+  // a full core reset.
+  invalidate_core_state();
+  try {
+    wait_for_byte_transfer(issue_time);
+    getNode(kCmdNode).write(kStopCmd);
+    getClient().dispatch();
+  } catch (const std::exception& e) {
+    TLOG_DEBUG(10) << "Failed to stop the aborted transfer on " << getId() << ": " << e.what();
   }
+}
+//-----------------------------------------------------------------------------
 
-  // At this point, we've either had too many retries, or the
-  // Transfer in Progress (TIP) bit went low.  If the TIP bit
-  // did go low, then we do a couple of other checks to see if
-  // the bus operated as expected:
+//-----------------------------------------------------------------------------
+void
+I2CMasterNode::check_transfer_status(uint32_t i2c_status, // NOLINT(build/unsigned)
+                                     bool require_acknowledgement,
+                                     bool require_bus_idle_at_end) const
+{
+  bool received_acknowledge = !(i2c_status & kReceivedAckBit);
+  bool busy = (i2c_status & kBusyBit);
+  bool arbitration_lost = (i2c_status & kArbitrationLostBit);
+  bool transfer_in_progress = (i2c_status & kInProgressBit);
+
+  // A NACK is the slave's business, anything else leaves the core in an unknown state
+  if (arbitration_lost) {
+    invalidate_core_state();
+    throw I2CBusArbitrationLost(ERS_HERE, getId());
+  }
 
-  if (attempt > max_retry) {
+  // The next command has already been issued on the assumption that this transfer was complete
+  if (transfer_in_progress) {
+    invalidate_core_state();
     throw I2CTransactionTimeout(ERS_HERE, getId());
   }
 
@@ -499,9 +690,11 @@ I2CMasterNode::wait_until_finished(bool require_acknowledgement, bool require_bu
   }
 
   if (require_bus_idle_at_end && busy) {
+    invalidate_core_state();
     throw I2CTransferFinishedBusStillBusy(ERS_HERE, getId());
   }
 }
+//-----------------------------------------------------------------------------
 
 } // namespace timing
-} // namespace dunedaq
\ No newline at end of file
+} // namespace dunedaq
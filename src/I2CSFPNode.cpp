@@ -10,6 +10,9 @@
 
 #include "logging/Logging.hpp"
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,6 +20,9 @@
 namespace dunedaq {
 namespace timing {
 
+std::map<std::string, std::shared_ptr<const I2CSFPSlave::StaticInfo>> I2CSFPSlave::s_static_info_cache;
+std::mutex I2CSFPSlave::s_static_info_cache_mutex;
+
 //-----------------------------------------------------------------------------
 I2CSFPSlave::I2CSFPSlave(const I2CMasterNode* i2c_master, uint8_t address) // NOLINT(build/unsigned)
   : I2CSlave(i2c_master, address)
@@ -60,16 +66,7 @@ I2CSFPSlave::read_calibration_parameter_pair(uint32_t calib_parameter_id) const
   ddm_available();
 
   auto parameter_array = this->read_i2cArray(0x51, m_calibration_parameter_start_addresses.at(calib_parameter_id), 0x4);
-
-  // slope
-  double slope = parameter_array.at(0) + (parameter_array.at(1) / 256.0);
-
-  uint32_t offset_raw = (parameter_array.at(2) & 0x7f) << 8 | parameter_array.at(3); // NOLINT(build/unsigned)
-
-  // eighth bit corresponds to sign
-  double offset = parameter_array.at(2) & (1UL << 7) ? offset_raw - 0x8000 : offset_raw;
-
-  return std::make_pair(slope, offset);
+  return decode_calibration_parameter_pair(parameter_array, 0);
 }
 //-----------------------------------------------------------------------------
 
@@ -79,10 +76,7 @@ I2CSFPSlave::read_temperature_raw() const
 {
   ddm_available();
   auto temperature_array = this->read_i2cArray(0x51, 0x60, 0x2);
-
-  // bit 7 corresponds to temperature sign, 0 for pos, 1 for neg
-  double temperature = temperature_array.at(0) & (1UL << 7) ? (temperature_array.at(0) & 0x7f) - 0xff : temperature_array.at(0);
-  return temperature + (temperature_array.at(1) / 256.0);
+  return decode_temperature_raw(temperature_array, 0);
 }
 //-----------------------------------------------------------------------------
 
@@ -102,7 +96,7 @@ I2CSFPSlave::read_voltage_raw() const
 {
   ddm_available();
   auto voltage_array = this->read_i2cArray(0x51, 0x62, 0x2);
-  return (voltage_array.at(0) << 8) | voltage_array.at(1);
+  return decode_word(voltage_array, 0);
 }
 //-----------------------------------------------------------------------------
 
@@ -122,7 +116,7 @@ I2CSFPSlave::read_rx_power_raw() const
 {
   ddm_available();
   auto rx_power_array = this->read_i2cArray(0x51, 0x68, 0x2);
-  return (rx_power_array.at(0) << 8) | rx_power_array.at(1);
+  return decode_word(rx_power_array, 0);
 }
 //-----------------------------------------------------------------------------
 
@@ -131,27 +125,13 @@ double
 I2CSFPSlave::read_rx_ower() const
 {
   auto rx_power_raw = this->read_rx_power_raw();
-  // rx power calib constants, 5 4-byte parameters, IEEE 754 float encoding
-  std::vector<uint32_t> rx_param_start_adr = { 0x48, 0x44, 0x40, 0x3C, 0x38 }; // NOLINT(build/unsigned)
+  // rx power calib constants, 5 4-byte parameters at 0x38-0x4b, highest order first, IEEE 754 float encoding
+  auto parameter_array = this->read_i2cArray(0x51, 0x38, 0x14);
   std::vector<double> rx_parameters;
-  for (auto it = rx_param_start_adr.begin(); it != rx_param_start_adr.end(); ++it) {
-    uint32_t parameter_bits = 0; // NOLINT(build/unsigned)
-    auto parameter_array = this->read_i2cArray(0x51, *it, 0x4);
-
-    for (auto jt = parameter_array.begin(); jt != parameter_array.end(); ++jt)
-      parameter_bits = (parameter_bits << 8) | *jt;
-
-    // convert the 32 bits to a float according IEEE 754
-    double parameter = convert_bits_to_float(parameter_bits);
-    rx_parameters.push_back(parameter);
-  }
-
-  double rx_power_calib = 0;
-  for (uint32_t i = 0; i < rx_parameters.size(); ++i) { // NOLINT(build/unsigned)
-    double parameter = rx_parameters.at(i);
-    rx_power_calib = rx_power_calib + (parameter * pow(rx_power_raw, i));
+  for (size_t offset : { 0x10, 0xc, 0x8, 0x4, 0x0 }) {
+    rx_parameters.push_back(decode_float(parameter_array, offset));
   }
-  return rx_power_calib * 0.1;
+  return calibrate_rx_power(rx_power_raw, rx_parameters);
 }
 //-----------------------------------------------------------------------------
 
@@ -161,7 +141,7 @@ I2CSFPSlave::read_tx_power_raw() const
 {
   ddm_available();
   auto tx_power_array = this->read_i2cArray(0x51, 0x66, 0x2);
-  return (tx_power_array.at(0) << 8) | tx_power_array.at(1);
+  return decode_word(tx_power_array, 0);
 }
 //-----------------------------------------------------------------------------
 
@@ -181,7 +161,7 @@ I2CSFPSlave::read_current_raw() const
 {
   ddm_available();
   auto current_array = this->read_i2cArray(0x51, 0x64, 0x2);
-  return (current_array.at(0) << 8) | current_array.at(1);
+  return decode_word(current_array, 0);
 }
 //-----------------------------------------------------------------------------
 
@@ -322,33 +302,201 @@ I2CSFPSlave::switch_soft_tx_control_bit(bool turn_on) const
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+std::shared_ptr<const I2CSFPSlave::StaticInfo>
+I2CSFPSlave::read_static_info() const
+{
+  sfp_reachable();
+
+  // Serial numbers are only unique for a given vendor and part: vendor name to serial number, A0h 0x14-0x53
+  auto id_characters = this->read_i2cArray(0x14, 0x40);
+  std::string vendor_name(id_characters.begin(), id_characters.begin() + 0x10);
+  std::string vendor_pn(id_characters.begin() + 0x14, id_characters.begin() + 0x24);
+  std::string serial_number(id_characters.begin() + 0x30, id_characters.begin() + 0x40);
+  // The fields have a fixed width, the concatenation is unambiguous
+  std::string cache_key = vendor_name + vendor_pn + serial_number;
+
+  // Blank serial numbers cannot tell modules apart, never cache them
+  bool cacheable = (serial_number.find_first_not_of(std::string(" \0\xff", 3)) != std::string::npos);
+
+  if (cacheable) {
+    std::lock_guard<std::mutex> lock(s_static_info_cache_mutex);
+    auto it = s_static_info_cache.find(cache_key);
+    if (it != s_static_info_cache.end()) {
+      return it->second;
+    }
+  }
+
+  // Identity block, A0h 0x00-0x5f
+  auto identity = this->read_i2cArray(0x0, 0x60);
+
+  auto info = std::make_shared<StaticInfo>();
+  info->vendor_name = std::string(identity.begin() + 0x14, identity.begin() + 0x24);
+  info->vendor_pn = std::string(identity.begin() + 0x28, identity.begin() + 0x38);
+  info->serial_number = std::string(identity.begin() + 0x44, identity.begin() + 0x54);
+  // Bit 6 of reg 5C: DDM supported, bit 2: I2C address swap required
+  info->ddm_supported = identity.at(0x5c) & 0x40;
+  info->address_swap_required = identity.at(0x5c) & 0x4;
+  // Bit 6 of reg 5D: soft tx control implemented
+  info->soft_tx_control_supported = identity.at(0x5d) & 0x40;
+
+  if (info->ddm_supported && !info->address_swap_required) {
+    // Calibration constants, A2h 0x38-0x5f
+    auto calibration = this->read_i2cArray(0x51, 0x38, 0x28);
+
+    for (auto address : m_calibration_parameter_start_addresses) {
+      info->calibration_pairs.push_back(decode_calibration_parameter_pair(calibration, address - 0x38));
+    }
+    for (size_t offset : { 0x10, 0xc, 0x8, 0x4, 0x0 }) {
+      info->rx_power_parameters.push_back(decode_float(calibration, offset));
+    }
+  }
+
+  // Only cache what was read from the module identified above
+  if (cacheable && info->vendor_name == vendor_name && info->vendor_pn == vendor_pn &&
+      info->serial_number == serial_number) {
+    std::lock_guard<std::mutex> lock(s_static_info_cache_mutex);
+    s_static_info_cache[cache_key] = info;
+  }
+
+  return info;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+I2CSFPSlave::Snapshot
+I2CSFPSlave::read_snapshot() const
+{
+  Snapshot snapshot;
+  snapshot.static_info = this->read_static_info();
+  snapshot.ddm_valid = false;
+
+  const StaticInfo& info = *snapshot.static_info;
+  if (!info.ddm_supported || info.address_swap_required) {
+    return snapshot;
+  }
+
+  // Diagnostics block, A2h 0x60-0x6f
+  auto diagnostics = this->read_i2cArray(0x51, 0x60, 0x10);
+
+  double temperature_raw = decode_temperature_raw(diagnostics, 0x0);
+  double voltage_raw = decode_word(diagnostics, 0x2);
+  double current_raw = decode_word(diagnostics, 0x4);
+  double tx_power_raw = decode_word(diagnostics, 0x6);
+  double rx_power_raw = decode_word(diagnostics, 0x8);
+
+  snapshot.laser_current = ((current_raw * info.calibration_pairs.at(0).first) + info.calibration_pairs.at(0).second) * 0.002;
+  snapshot.tx_power = ((tx_power_raw * info.calibration_pairs.at(1).first) + info.calibration_pairs.at(1).second) * 0.1;
+  snapshot.temperature = temperature_raw * info.calibration_pairs.at(2).first + info.calibration_pairs.at(2).second;
+  snapshot.supply_voltage = ((voltage_raw * info.calibration_pairs.at(3).first) + info.calibration_pairs.at(3).second) * 1e-4;
+  snapshot.rx_power = calibrate_rx_power(rx_power_raw, info.rx_power_parameters);
+
+  // Optional status/control byte 0x6e: bit 7 tx_disable pin, bit 6 soft tx_disable
+  snapshot.tx_disable_hw = diagnostics.at(0xe) & 0x80;
+  snapshot.tx_disable_sw = diagnostics.at(0xe) & 0x40;
+
+  snapshot.ddm_valid = true;
+  return snapshot;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+I2CSFPSlave::clear_static_info_cache()
+{
+  std::lock_guard<std::mutex> lock(s_static_info_cache_mutex);
+  s_static_info_cache.clear();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::pair<double, double>
+I2CSFPSlave::decode_calibration_parameter_pair(const std::vector<uint8_t>& data, size_t offset) // NOLINT(build/unsigned)
+{
+  // slope
+  double slope = data.at(offset) + (data.at(offset + 1) / 256.0);
+
+  uint32_t offset_raw = (data.at(offset + 2) & 0x7f) << 8 | data.at(offset + 3); // NOLINT(build/unsigned)
+
+  // eighth bit corresponds to sign
+  double calib_offset = data.at(offset + 2) & (1UL << 7) ? offset_raw - 0x8000 : offset_raw;
+
+  return std::make_pair(slope, calib_offset);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+double
+I2CSFPSlave::decode_temperature_raw(const std::vector<uint8_t>& data, size_t offset) // NOLINT(build/unsigned)
+{
+  // bit 7 corresponds to temperature sign, 0 for pos, 1 for neg
+  double temperature = data.at(offset) & (1UL << 7) ? (data.at(offset) & 0x7f) - 0xff : data.at(offset);
+  return temperature + (data.at(offset + 1) / 256.0);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+double
+I2CSFPSlave::decode_word(const std::vector<uint8_t>& data, size_t offset) // NOLINT(build/unsigned)
+{
+  return (data.at(offset) << 8) | data.at(offset + 1);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+double
+I2CSFPSlave::decode_float(const std::vector<uint8_t>& data, size_t offset) // NOLINT(build/unsigned)
+{
+  uint32_t parameter_bits = 0; // NOLINT(build/unsigned)
+  for (size_t i(0); i < 4; ++i)
+    parameter_bits = (parameter_bits << 8) | data.at(offset + i);
+
+  // convert the 32 bits to a float according IEEE 754
+  return convert_bits_to_float(parameter_bits);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+double
+I2CSFPSlave::calibrate_rx_power(double rx_power_raw, const std::vector<double>& parameters)
+{
+  double rx_power_calib = 0;
+  for (uint32_t i = 0; i < parameters.size(); ++i) { // NOLINT(build/unsigned)
+    double parameter = parameters.at(i);
+    rx_power_calib = rx_power_calib + (parameter * pow(rx_power_raw, i));
+  }
+  return rx_power_calib * 0.1;
+}
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 std::string
 I2CSFPSlave::get_status(bool print_out) const
 {
-  sfp_reachable();
+  auto snapshot = read_snapshot();
+  const StaticInfo& info = *snapshot.static_info;
 
   std::stringstream status;
   std::vector<std::pair<std::string, std::string>> sfp_info;
 
   // Vendor name
-  sfp_info.push_back(std::make_pair("Vendor", read_vendor_name()));
+  sfp_info.push_back(std::make_pair("Vendor", info.vendor_name));
 
   // Vendor part number
-  sfp_info.push_back(std::make_pair("Part number", read_vendor_part_number()));
+  sfp_info.push_back(std::make_pair("Part number", info.vendor_pn));
 
   // Serial number
-  sfp_info.push_back(std::make_pair("Serial number", read_serial_number()));
+  sfp_info.push_back(std::make_pair("Serial number", info.serial_number));
 
   // Does the SFP support DDM
-  if (!read_ddm_support_bit()) {
+  if (!info.ddm_supported) {
     TLOG() << "DDM not available for SFP on I2C bus: " << get_master_id();
     status << format_reg_table(sfp_info, "SFP status", { "", "" });
     if (print_out)
       TLOG() << status.str();
     return status.str();
   } else {
-    if (read_i2c_reg_addressSwapBit()) {
+    if (info.address_swap_required) {
       TLOG() << "SFP DDM I2C address swap not supported. SFP on I2C bus: " << get_master_id();
       status << format_reg_table(sfp_info, "SFP status", { "", "" });
       if (print_out)
@@ -358,33 +506,33 @@ I2CSFPSlave::get_status(bool print_out) const
   }
 
   std::stringstream temperature_stream;
-  temperature_stream << std::dec << std::fixed << std::setprecision(2) << read_temperature() << " C";
+  temperature_stream << std::dec << std::fixed << std::setprecision(2) << snapshot.temperature << " C";
   sfp_info.push_back(std::make_pair("Temperature", temperature_stream.str()));
 
   std::stringstream voltage_stream;
-  voltage_stream << std::dec << std::fixed << std::setprecision(2) << read_voltage() << " V";
+  voltage_stream << std::dec << std::fixed << std::setprecision(2) << snapshot.supply_voltage << " V";
   sfp_info.push_back(std::make_pair("Supply voltage", voltage_stream.str()));
 
   std::stringstream rx_power_stream;
-  rx_power_stream << std::dec << std::fixed << std::setprecision(2) << read_rx_ower() << " uW";
+  rx_power_stream << std::dec << std::fixed << std::setprecision(2) << snapshot.rx_power << " uW";
   sfp_info.push_back(std::make_pair("Rx power", rx_power_stream.str()));
 
   std::stringstream tx_power_stream;
-  tx_power_stream << std::dec << std::fixed << std::setprecision(2) << read_tx_power() << " uW";
+  tx_power_stream << std::dec << std::fixed << std::setprecision(2) << snapshot.tx_power << " uW";
   sfp_info.push_back(std::make_pair("Tx power", tx_power_stream.str()));
 
   std::stringstream current_stream;
-  current_stream << std::dec << std::fixed << std::setprecision(2) << read_current() << " uA";
+  current_stream << std::dec << std::fixed << std::setprecision(2) << snapshot.laser_current << " uA";
   sfp_info.push_back(std::make_pair("Tx current", current_stream.str()));
 
-  if (read_soft_tx_control_support_bit()) {
+  if (info.soft_tx_control_supported) {
     // sfp_info.push_back(std::make_pair("Soft Tx disbale supported",  "True"));
-    sfp_info.push_back(std::make_pair("Tx disable bit", std::to_string(read_soft_tx_control_state())));
+    sfp_info.push_back(std::make_pair("Tx disable bit", std::to_string(snapshot.tx_disable_sw)));
   } else {
     sfp_info.push_back(std::make_pair("Soft Tx disbale supported", "False"));
   }
 
-  sfp_info.push_back(std::make_pair("Tx disable pin", std::to_string(read_tx_disable_pin_state())));
+  sfp_info.push_back(std::make_pair("Tx disable pin", std::to_string(snapshot.tx_disable_hw)));
 
   status << format_reg_table(sfp_info, "SFP status", { "", "" });
   if (print_out)
@@ -399,45 +547,46 @@ I2CSFPSlave::get_info(timinghardwareinfo::TimingSFPMonitorData& mon_data) const
 {
   mon_data.data_valid = false;
 
-  sfp_reachable();
+  auto snapshot = this->read_snapshot();
+  const StaticInfo& info = *snapshot.static_info;
 
   // Vendor name
-  mon_data.vendor_name = this->read_vendor_name();
+  mon_data.vendor_name = info.vendor_name;
 
   // Vendor part number
-  mon_data.vendor_pn = this->read_vendor_part_number();
+  mon_data.vendor_pn = info.vendor_pn;
 
   // Serial number TP DO?
   // sfp_info.push_back(std::make_pair("Serial number", read_serial_number()));
 
   // Does the SFP support DDM
-  if (!this->read_ddm_support_bit()) {
+  if (!info.ddm_supported) {
     TLOG() << "DDM not available for SFP on I2C bus: " << get_master_id();
     mon_data.ddm_supported = false;
     return;
   } else {
     mon_data.ddm_supported = true;
-    if (this->read_i2c_reg_addressSwapBit()) {
+    if (info.address_swap_required) {
       TLOG() << "SFP DDM I2C address swap not supported. SFP on I2C bus: " << get_master_id();
       return;
     }
   }
 
-  mon_data.temperature = this->read_temperature();
+  mon_data.temperature = snapshot.temperature;
 
-  mon_data.supply_voltage = this->read_voltage();
+  mon_data.supply_voltage = snapshot.supply_voltage;
 
-  mon_data.rx_power = this->read_rx_ower();
+  mon_data.rx_power = snapshot.rx_power;
 
-  mon_data.tx_power = this->read_tx_power();
+  mon_data.tx_power = snapshot.tx_power;
 
-  mon_data.laser_current = this->read_current();
+  mon_data.laser_current = snapshot.laser_current;
 
-  mon_data.tx_disable_sw_supported = this->read_soft_tx_control_support_bit();
+  mon_data.tx_disable_sw_supported = info.soft_tx_control_supported;
 
-  mon_data.tx_disable_sw = this->read_soft_tx_control_state();
+  mon_data.tx_disable_sw = snapshot.tx_disable_sw;
 
-  mon_data.tx_disable_hw = this->read_tx_disable_pin_state();
+  mon_data.tx_disable_hw = snapshot.tx_disable_hw;
 
   mon_data.data_valid = true;
 }
@@ -40,7 +40,10 @@ IONode::IONode(const uhal::Node& node,
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-IONode::~IONode() {}
+IONode::~IONode()
+{
+  stop_i2c_info_sampler();
+}
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
@@ -87,6 +90,7 @@ IONode::read_firmware_frequency() const
 uint64_t // NOLINT(build/unsigned)
 IONode::read_board_uid() const
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 
   uint64_t uid = 0;                // NOLINT(build/unsigned)
   std::vector<uint8_t> uid_values = // NOLINT(build/unsigned)
@@ -166,6 +170,7 @@ IONode::get_hardware_info(bool print_out) const
 std::string
 IONode::get_full_clock_config_file_path(const std::string& clock_config_file, int32_t mode) const
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 
   if (clock_config_file.size()) {
     // config file provided explicitly, no need for lookup
@@ -259,16 +264,18 @@ IONode::get_pll() const
 
 //-----------------------------------------------------------------------------
 void
-IONode::configure_pll(const std::string& clock_config_file) const
+IONode::configure_pll(const std::string& clock_config_file, bool warm_restart) const
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   auto pll = get_pll();
 
   uint32_t si_pll_version = pll->read_device_version(); // NOLINT(build/unsigned)
   TLOG_DEBUG(0) << "Configuring PLL        : SI" << format_reg_value(si_pll_version);
 
-  pll->configure(clock_config_file);
+  pll->configure(clock_config_file, warm_restart);
 
   TLOG_DEBUG(0) << "PLL configuration id   : " << pll->read_config_id();
+  TLOG_DEBUG(0) << "PLL settle time        : " << pll->get_settle_time() << " ms";
 }
 //-----------------------------------------------------------------------------
 
@@ -300,46 +307,47 @@ IONode::get_clock_frequencies_table(bool print_out) const
 std::string
 IONode::get_pll_status(bool print_out) const
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 
   std::stringstream status;
 
   auto pll = get_pll();
-  status << "PLL configuration id   : " << pll->read_config_id() << std::endl;
 
-  std::map<std::string, uint32_t> pll_version; // NOLINT(build/unsigned)
-  pll_version["Part number"] = pll->read_device_version();
-  pll_version["Device grade"] = pll->read_clock_register(0x4);
-  pll_version["Device revision"] = pll->read_clock_register(0x5);
+  timinghardwareinfo::TimingPLLMonitorData pll_mon_data;
+  pll->get_info(pll_mon_data);
+
+  status << "PLL configuration id   : " << pll_mon_data.config_id << std::endl;
+
+  // Part number (0x2-0x3), device grade (0x4) and revision (0x5) in one go
+  auto version = pll->read_clock_registers(0x2, 4);
+
+  std::map<std::string, uint32_t> pll_version;                                            // NOLINT(build/unsigned)
+  pll_version["Part number"] = ((uint32_t)version.at(1) << 8) + (uint32_t)version.at(0); // NOLINT(build/unsigned)
+  pll_version["Device grade"] = version.at(2);
+  pll_version["Device revision"] = version.at(3);
 
   status << format_reg_table(pll_version, "PLL information") << std::endl;
 
   std::map<std::string, uint32_t> pll_registers; // NOLINT(build/unsigned)
 
-  uint8_t pll_reg_c = pll->read_clock_register(0xc);   // NOLINT(build/unsigned)
-  uint8_t pll_reg_d = pll->read_clock_register(0xd);   // NOLINT(build/unsigned)
-  uint8_t pll_reg_e = pll->read_clock_register(0xe);   // NOLINT(build/unsigned)
-  uint8_t pll_reg_f = pll->read_clock_register(0xf);   // NOLINT(build/unsigned)
-  uint8_t pll_reg_11 = pll->read_clock_register(0x11); // NOLINT(build/unsigned)
-  uint8_t pll_reg_12 = pll->read_clock_register(0x12); // NOLINT(build/unsigned)
+  pll_registers["CAL_PLL"] = pll_mon_data.cal_pll;
+  pll_registers["HOLD"] = pll_mon_data.hold;
+  pll_registers["LOL"] = pll_mon_data.lol;
+  pll_registers["LOS"] = pll_mon_data.los;
+  pll_registers["LOSXAXB"] = pll_mon_data.los_xaxb;
+  pll_registers["LOSXAXB_FLG"] = pll_mon_data.los_xaxb_flg;
 
-  pll_registers["CAL_PLL"] = dec_rng(pll_reg_f, 5);
-  pll_registers["HOLD"] = dec_rng(pll_reg_e, 5);
-  pll_registers["LOL"] = dec_rng(pll_reg_e, 1);
-  pll_registers["LOS"] = dec_rng(pll_reg_d, 0, 4);
-  pll_registers["LOSXAXB"] = dec_rng(pll_reg_c, 1);
-  pll_registers["LOSXAXB_FLG"] = dec_rng(pll_reg_11, 1);
+  pll_registers["OOF"] = pll_mon_data.oof;
+  pll_registers["OOF (sticky)"] = pll_mon_data.oof_sticky;
 
-  pll_registers["OOF"] = dec_rng(pll_reg_d, 4, 4);
-  pll_registers["OOF (sticky)"] = dec_rng(pll_reg_12, 4, 4);
+  pll_registers["SMBUS_TIMEOUT"] = pll_mon_data.smbus_timeout;
+  pll_registers["SMBUS_TIMEOUT_FLG"] = pll_mon_data.smbus_timeout_flg;
 
-  pll_registers["SMBUS_TIMEOUT"] = dec_rng(pll_reg_c, 5);
-  pll_registers["SMBUS_TIMEOUT_FLG"] = dec_rng(pll_reg_11, 5);
+  pll_registers["SYSINCAL"] = pll_mon_data.sys_in_cal;
+  pll_registers["SYSINCAL_FLG"] = pll_mon_data.sys_in_cal_flg;
 
-  pll_registers["SYSINCAL"] = dec_rng(pll_reg_c, 0);
-  pll_registers["SYSINCAL_FLG"] = dec_rng(pll_reg_11, 0);
-
-  pll_registers["XAXB_ERR"] = dec_rng(pll_reg_c, 3);
-  pll_registers["XAXB_ERR_FLG"] = dec_rng(pll_reg_11, 3);
+  pll_registers["XAXB_ERR"] = pll_mon_data.xaxb_err;
+  pll_registers["XAXB_ERR_FLG"] = pll_mon_data.xaxb_err_flg;
 
   status << format_reg_table(pll_registers, "PLL state");
 
@@ -353,8 +361,27 @@ IONode::get_pll_status(bool print_out) const
 void
 IONode::write_soft_reset_register() const
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   getNode("csr.ctrl.soft_rst").write(0x1);
   getClient().dispatch();
+
+  invalidate_i2c_core_states();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+IONode::invalidate_i2c_core_states() const
+{
+  std::vector<std::string> i2c_buses = m_sfp_i2c_buses;
+  i2c_buses.push_back(m_uid_i2c_bus);
+  i2c_buses.push_back(m_pll_i2c_bus);
+
+  for (auto& i2c_bus : i2c_buses) {
+    if (i2c_bus.empty())
+      continue;
+    getNode<I2CMasterNode>(i2c_bus).invalidate_core_state();
+  }
 }
 //-----------------------------------------------------------------------------
 
@@ -371,6 +398,7 @@ IONode::soft_reset() const
 std::string
 IONode::get_sfp_status(uint32_t sfp_id, bool print_out) const // NOLINT(build/unsigned)
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   std::stringstream status;
   std::string sfp_i2c_bus;
   try {
@@ -390,6 +418,7 @@ IONode::get_sfp_status(uint32_t sfp_id, bool print_out) const // NOLINT(build/un
 void
 IONode::switch_sfp_soft_tx_control_bit(uint32_t sfp_id, bool turn_on) const // NOLINT(build/unsigned)
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   std::string sfp_i2c_bus;
   try {
     sfp_i2c_bus = m_sfp_i2c_buses.at(sfp_id);
@@ -401,5 +430,51 @@ IONode::switch_sfp_soft_tx_control_bit(uint32_t sfp_id, bool turn_on) const // N
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+void
+IONode::start_i2c_info_sampler(std::chrono::milliseconds period) const
+{
+  m_i2c_sampler.start(
+    [this]() {
+      std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
+      return sample_i2c_info(2);
+    },
+    period);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+IONode::stop_i2c_info_sampler() const
+{
+  m_i2c_sampler.stop();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+IONode::sample_i2c_info(int /*level*/) const
+{
+  timinghardwareinfo::TimingPLLMonitorData pll_mon_data;
+  get_pll()->get_info(pll_mon_data);
+
+  return [pll_mon_data](opmonlib::InfoCollector& ci) { ci.add(pll_mon_data); };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+IONode::queue_i2c_info(int level) const
+{
+  if (m_i2c_sampler.is_running()) {
+    return [this](opmonlib::InfoCollector& ci) { m_i2c_sampler.get_info(ci); };
+  }
+  return [this, level](opmonlib::InfoCollector& ci) {
+    std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
+    sample_i2c_info(level)(ci);
+  };
+}
+//-----------------------------------------------------------------------------
+
 } // namespace timing
 } // namespace dunedaq
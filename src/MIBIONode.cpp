@@ -8,6 +8,7 @@
 
 #include "timing/MIBIONode.hpp"
 
+#include <memory>
 #include <string>
 #include <math.h>
 
@@ -24,7 +25,10 @@ MIBIONode::MIBIONode(const uhal::Node& node)
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-MIBIONode::~MIBIONode() {}
+MIBIONode::~MIBIONode()
+{
+  stop_i2c_info_sampler();
+}
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
@@ -51,42 +55,45 @@ MIBIONode::get_status(bool print_out) const
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-void
-MIBIONode::configure_pll(const std::string& clock_config_file) const
+std::unique_ptr<const SI534xSlave>
+MIBIONode::get_pll() const
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   // enable pll channel (#3) only
-  auto i2c_switch = get_i2c_device<I2C9546SwitchSlave>("i2c", "TCA9546_Switch");
-  i2c_switch->set_channels_states(8);
-  IONode::configure_pll(clock_config_file);
+  select_i2c_switch_channel(3);
+  return IONode::get_pll();
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-std::string
-MIBIONode::get_pll_status(bool print_out) const
+void
+MIBIONode::select_i2c_switch_channel(uint8_t channel) const // NOLINT(build/unsigned)
 {
-  // enable pll channel (#3) only
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   auto i2c_switch = get_i2c_device<I2C9546SwitchSlave>("i2c", "TCA9546_Switch");
-  i2c_switch->set_channels_states(8);
-  return IONode::get_pll_status(print_out);
+  i2c_switch->select_channels(1UL << channel);
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 void
-MIBIONode::reset(int32_t fanout_mode, const std::string& clock_config_file) const
+MIBIONode::reset(int32_t fanout_mode, const std::string& clock_config_file, bool warm_restart) const
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   
   write_soft_reset_register();
 
   millisleep(1000);
+
+  // the switch may have been reset along with the board, its channel states are unknown
+  get_i2c_device<I2C9546SwitchSlave>("i2c", "TCA9546_Switch")->invalidate_channels_states();
   
   // Find the right pll config file
   std::string clock_config_path = get_full_clock_config_file_path(clock_config_file, fanout_mode);
   TLOG() << "PLL configuration file : " << clock_config_path;
 
   // Upload config file to PLL
-  configure_pll(clock_config_path);
+  configure_pll(clock_config_path, warm_restart);
 
   // Reset mmcm
   getNode("csr.ctrl.rst").write(0x1);
@@ -104,9 +111,9 @@ MIBIONode::reset(int32_t fanout_mode, const std::string& clock_config_file) cons
 
 //-----------------------------------------------------------------------------
 void
-MIBIONode::reset(const std::string& clock_config_file) const
+MIBIONode::reset(const std::string& clock_config_file, bool warm_restart) const
 {
-  reset(-1, clock_config_file);
+  reset(-1, clock_config_file, warm_restart);
 }
 //-----------------------------------------------------------------------------
 
@@ -158,29 +165,18 @@ MIBIONode::read_active_upstream_mux_channel() const
 //-----------------------------------------------------------------------------
 std::string
 MIBIONode::get_sfp_status(uint32_t sfp_id, bool print_out) const { // NOLINT(build/unsigned)
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   std::stringstream status;
   
   validate_sfp_id(sfp_id);
 
   // enable i2c path for sfp
-  auto i2c_switch = get_i2c_device<I2C9546SwitchSlave>("i2c", "TCA9546_Switch");
-  i2c_switch->set_channels_states(1UL << sfp_id);
+  select_i2c_switch_channel(sfp_id);
 
   auto sfp = get_i2c_device<I2CSFPSlave>(m_sfp_i2c_buses.at(0), "SFP_EEProm");
 
   status << "SFP " << sfp_id << ":" << std::endl;
-  
-  try
-  {
-    status << sfp->get_status();
-  }
-  catch(...)
-  {
-    i2c_switch->set_channels_states(8);
-    throw;
-  }
-
-  i2c_switch->set_channels_states(8);
+  status << sfp->get_status();
 
   if (print_out)
     TLOG() << status.str();
@@ -192,13 +188,12 @@ MIBIONode::get_sfp_status(uint32_t sfp_id, bool print_out) const { // NOLINT(bui
 //-----------------------------------------------------------------------------
 void
 MIBIONode::switch_sfp_soft_tx_control_bit(uint32_t sfp_id, bool turn_on) const { // NOLINT(build/unsigned)
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   validate_sfp_id(sfp_id);
 
-  auto i2c_switch = get_i2c_device<I2C9546SwitchSlave>("i2c", "TCA9546_Switch");
-  i2c_switch->set_channels_states(1UL << sfp_id);
+  select_i2c_switch_channel(sfp_id);
   auto sfp = get_i2c_device<I2CSFPSlave>(m_sfp_i2c_buses.at(0), "SFP_EEProm");
   sfp->switch_soft_tx_control_bit(turn_on);
-  i2c_switch->set_channels_states(8);
 }
 //-----------------------------------------------------------------------------
 
@@ -206,69 +201,117 @@ MIBIONode::switch_sfp_soft_tx_control_bit(uint32_t sfp_id, bool turn_on) const {
 void
 MIBIONode::get_info(timinghardwareinfo::TimingMIBMonitorData& mon_data) const
 {
+  auto decoder = queue_monitor_data();
+  getClient().dispatch();
+  decoder(mon_data);
+}
+//-----------------------------------------------------------------------------
 
-  auto subnodes = read_sub_nodes(getNode("csr.stat"));
+//-----------------------------------------------------------------------------
+void
+MIBIONode::get_info(opmonlib::InfoCollector& ci, int level) const
+{
+  collect_info(ci, level);
+}
+//-----------------------------------------------------------------------------
 
-  mon_data.cdr_0_lol = subnodes.at("cdr_lol").value() & 0x1;
-  mon_data.cdr_1_lol = subnodes.at("cdr_lol").value() & 0x2;
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+MIBIONode::queue_info(int level) const
+{
+  // the I2C data is read at decode time, or taken from the background sampler
+  InfoDecoder i2c_decoder;
+  if (level >= 2) {
+    i2c_decoder = queue_i2c_info(level);
+  }
 
-  mon_data.cdr_0_los = subnodes.at("cdr_los").value() & 0x1;
-  mon_data.cdr_1_los = subnodes.at("cdr_los").value() & 0x2;
+  std::function<void(timinghardwareinfo::TimingMIBMonitorData&)> decoder;
+  if (level >= 1) {
+    decoder = queue_monitor_data();
+  }
 
-  mon_data.mmcm_ok = subnodes.at("mmcm_ok").value();
-  mon_data.mmcm_sticky = subnodes.at("mmcm_sticky").value();
-  
-  mon_data.sfp_0_flt = subnodes.at("sfp_flt").value() & 0x1;
-  mon_data.sfp_1_flt = subnodes.at("sfp_flt").value() & 0x2;
+  return [i2c_decoder, decoder](opmonlib::InfoCollector& ci) {
+    if (i2c_decoder) {
+      i2c_decoder(ci);
+    }
+    if (decoder) {
+      timinghardwareinfo::TimingMIBMonitorData mon_data;
+      decoder(mon_data);
+      ci.add(mon_data);
+    }
+  };
+}
+//-----------------------------------------------------------------------------
 
-  mon_data.sfp_0_los = subnodes.at("sfp_los").value() & 0x1;
-  mon_data.sfp_1_los = subnodes.at("sfp_los").value() & 0x2;
+//-----------------------------------------------------------------------------
+std::function<void(timinghardwareinfo::TimingMIBMonitorData&)>
+MIBIONode::queue_monitor_data() const
+{
+  auto subnodes = read_sub_nodes(getNode("csr.stat"), false);
+
+  return [=](timinghardwareinfo::TimingMIBMonitorData& mon_data) {
+    mon_data.cdr_0_lol = subnodes.at("cdr_lol").value() & 0x1;
+    mon_data.cdr_1_lol = subnodes.at("cdr_lol").value() & 0x2;
+
+    mon_data.cdr_0_los = subnodes.at("cdr_los").value() & 0x1;
+    mon_data.cdr_1_los = subnodes.at("cdr_los").value() & 0x2;
+
+    mon_data.mmcm_ok = subnodes.at("mmcm_ok").value();
+    mon_data.mmcm_sticky = subnodes.at("mmcm_sticky").value();
 
-  // TODO 3rd SFP?
+    mon_data.sfp_0_flt = subnodes.at("sfp_flt").value() & 0x1;
+    mon_data.sfp_1_flt = subnodes.at("sfp_flt").value() & 0x2;
+
+    mon_data.sfp_0_los = subnodes.at("sfp_los").value() & 0x1;
+    mon_data.sfp_1_los = subnodes.at("sfp_los").value() & 0x2;
+
+    // TODO 3rd SFP?
+  };
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-void
-MIBIONode::get_info(opmonlib::InfoCollector& ci, int level) const
+TimingNode::InfoDecoder
+MIBIONode::sample_i2c_info(int level) const
 {
+  timinghardwareinfo::TimingPLLMonitorData pll_mon_data;
+  std::vector<std::pair<std::string, opmonlib::InfoCollector>> sfp_ics;
+
+  // sweep the switch channels starting from the one already selected: sfps on #0-2, pll on #3
   auto i2c_switch = get_i2c_device<I2C9546SwitchSlave>("i2c", "TCA9546_Switch");
+  for (uint i : i2c_switch->order_sweep({ 0, 1, 2, 3 }))
+  {
+    if (i == 3) {
+      get_pll()->get_info(pll_mon_data);
+      continue;
+    }
 
-  if (level >= 2) {
-    i2c_switch->set_channels_states(8);
+    opmonlib::InfoCollector sfp_ic;
+    
+    // enable i2c path for sfp
+    select_i2c_switch_channel(i);
 
-    timinghardwareinfo::TimingPLLMonitorData pll_mon_data;
-    get_pll()->get_info(pll_mon_data);
-    ci.add(pll_mon_data);
+    auto sfp = this->get_i2c_device<I2CSFPSlave>(m_sfp_i2c_buses.at(0), "SFP_EEProm");
     
-    for (uint i=0; i < 3; ++i)
+    try
     {
-      opmonlib::InfoCollector sfp_ic;
-      
-      // enable i2c path for sfp
-      i2c_switch->set_channels_states(1UL << i);
-
-      auto sfp = this->get_i2c_device<I2CSFPSlave>(m_sfp_i2c_buses.at(0), "SFP_EEProm");
-      
-      try
-      {
-        sfp->get_info(sfp_ic, level);
-      }
-      catch (timing::SFPUnreachable& e)
-      {
-        // It is valid that an SFP may not be installed, currently no good way of knowing whether they it should be
-        TLOG_DEBUG(2) << "Failed to communicate with SFP " << i <<  " on I2C switch channel " << (1UL << i) << " on i2c bus" << m_sfp_i2c_buses.at(0);
-        continue;
-      }
-      ci.add("sfp_"+std::to_string(i),sfp_ic);
+      sfp->get_info(sfp_ic, level);
     }
-    i2c_switch->set_channels_states(8);
-  }
-  if (level >= 1) {
-    timinghardwareinfo::TimingMIBMonitorData mon_data;
-    this->get_info(mon_data);
-    ci.add(mon_data);
+    catch (timing::SFPUnreachable& e)
+    {
+      // It is valid that an SFP may not be installed, currently no good way of knowing whether they it should be
+      TLOG_DEBUG(2) << "Failed to communicate with SFP " << i <<  " on I2C switch channel " << (1UL << i) << " on i2c bus" << m_sfp_i2c_buses.at(0);
+      continue;
+    }
+    sfp_ics.push_back(std::make_pair("sfp_"+std::to_string(i), sfp_ic));
   }
+
+  return [pll_mon_data, sfp_ics](opmonlib::InfoCollector& ci) {
+    ci.add(pll_mon_data);
+    for (auto sfp_ic : sfp_ics) {
+      ci.add(sfp_ic.first, sfp_ic.second);
+    }
+  };
 }
 //-----------------------------------------------------------------------------
 
@@ -138,13 +138,12 @@ MasterDesign::validate_firmware_version() const
 void
 MasterDesign::get_info(opmonlib::InfoCollector& ci, int level) const
 { 
-  opmonlib::InfoCollector master_collector;
-  this->get_master_node_plain()->get_info(master_collector, level);
-  ci.add("master", master_collector);
+  auto master_decoder = this->get_master_node_plain()->queue_info(level);
+  auto io_decoder = this->get_io_node_plain()->queue_info(level);
+  getClient().dispatch();
 
-  opmonlib::InfoCollector hardware_collector;
-  this->get_io_node_plain()->get_info(hardware_collector, level);
-  ci.add("io", hardware_collector);
+  decode_info(ci, "master", master_decoder);
+  decode_info(ci, "io", io_decoder);
 }
 //-----------------------------------------------------------------------------
 }
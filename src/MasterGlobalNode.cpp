@@ -11,15 +11,26 @@
 #include "logging/Logging.hpp"
 
 #include <string>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
 
 UHAL_REGISTER_DERIVED_NODE(MasterGlobalNode)
 
+const std::vector<std::string> MasterGlobalNode::kRegisterPaths = {
+  "csr.ctrl.resync_cdr",
+  "csr.ctrl.resync",
+  "csr.ctrl.clr_ctrs",
+  "csr.stat.rx_rdy",
+  "csr.stat.cdr_locked",
+  "csr.stat.ctrs_rdy",
+};
+
 //-----------------------------------------------------------------------------
 MasterGlobalNode::MasterGlobalNode(const uhal::Node& node)
   : TimingNode(node)
+  , m_registers(kRegisterPaths)
 {}
 //-----------------------------------------------------------------------------
 
@@ -47,22 +58,43 @@ MasterGlobalNode::get_status(bool print_out) const
 void
 MasterGlobalNode::enable_upstream_endpoint(uint32_t timeout) const // NOLINT(build/unsigned)
 {
-  getNode("csr.ctrl.resync_cdr").write(0x1);
-  getNode("csr.ctrl.resync").write(0x1);
+  reset_upstream_receiver();
+  wait_for_upstream_receiver(timeout);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+MasterGlobalNode::reset_upstream_receiver() const
+{
+  const uhal::Node& resync_cdr_node = m_registers.get(*this, kCtrlResyncCdr);
+  const uhal::Node& resync_node = m_registers.get(*this, kCtrlResync);
+
+  resync_cdr_node.write(0x1);
+  resync_node.write(0x1);
   getClient().dispatch();
 
-  getNode("csr.ctrl.resync_cdr").write(0x0);
-  getNode("csr.ctrl.resync").write(0x0);
+  resync_cdr_node.write(0x0);
+  resync_node.write(0x0);
   getClient().dispatch();
 
-  TLOG_DEBUG(4) << "Upstream CDR reset, waiting for lock";
+  TLOG_DEBUG(4) << "Upstream CDR reset";
+}
+//-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+void
+MasterGlobalNode::wait_for_upstream_receiver(uint32_t timeout) const // NOLINT(build/unsigned)
+{
   auto start = std::chrono::high_resolution_clock::now();
 
+  const uhal::Node& rx_ready_node = m_registers.get(*this, kStatRxRdy);
+  const uhal::Node& cdr_ready_node = m_registers.get(*this, kStatCdrLocked);
+
   // Wait for the rx and cdr to be happy
   while (true) {
-    auto rx_ready = getNode("csr.stat.rx_rdy").read();
-    auto cdr_ready = getNode("csr.stat.cdr_locked").read();
+    auto rx_ready = rx_ready_node.read();
+    auto cdr_ready = cdr_ready_node.read();
     getClient().dispatch();
 
     TLOG_DEBUG(6) << std::hex << "rx ready: 0x" << rx_ready.value() << ", cdr ready: " << cdr_ready.value();
@@ -88,7 +120,7 @@ MasterGlobalNode::enable_upstream_endpoint(uint32_t timeout) const // NOLINT(bui
 bool
 MasterGlobalNode::read_upstream_endpoint_ready() const
 {
-  auto rx_ready = getNode("csr.stat.rx_rdy").read();
+  auto rx_ready = m_registers.get(*this, kStatRxRdy).read();
   getClient().dispatch();
   return rx_ready.value();
 }
@@ -98,7 +130,7 @@ MasterGlobalNode::read_upstream_endpoint_ready() const
 void
 MasterGlobalNode::reset_command_counters(uint32_t timeout) const // NOLINT(build/unsigned)
 {
-  getNode("csr.ctrl.clr_ctrs").write(0x1);
+  m_registers.get(*this, kCtrlClrCtrs).write(0x1);
   getClient().dispatch();
 
   TLOG_DEBUG(1) << "Command counters reset, waiting for them to be ready";
@@ -107,6 +139,7 @@ MasterGlobalNode::reset_command_counters(uint32_t timeout) const // NOLINT(build
 
   std::chrono::milliseconds ms_since_start(0);
 
+  const uhal::Node& counters_ready_node = m_registers.get(*this, kStatCtrsRdy);
   uhal::ValWord<uint32_t> counters_ready;  // NOLINT(build/unsigned)
 
   // Wait for the endpoint to be happy
@@ -116,7 +149,7 @@ MasterGlobalNode::reset_command_counters(uint32_t timeout) const // NOLINT(build
 
     millisleep(10);
 
-    counters_ready = getNode("csr.stat.ctrs_rdy").read();
+    counters_ready = counters_ready_node.read();
     getClient().dispatch();
 
     TLOG_DEBUG(6) << "counters ready: 0x" << counters_ready.value();
@@ -140,7 +173,7 @@ MasterGlobalNode::reset_command_counters(uint32_t timeout) const // NOLINT(build
 bool
 MasterGlobalNode::read_counters_ready() const
 {
-  auto counters_ready = getNode("csr.stat.ctrs_rdy").read();
+  auto counters_ready = m_registers.get(*this, kStatCtrsRdy).read();
   getClient().dispatch();
   return counters_ready.value();
 }
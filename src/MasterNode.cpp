@@ -8,19 +8,41 @@
 
 #include "timing/MasterNode.hpp"
 #include "timing/MasterGlobalNode.hpp"
+#include "timing/TimingIssues.hpp"
 
+#include "ers/ers.hpp"
 #include "logging/Logging.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <string>
+#include <thread>
 
 namespace dunedaq {
 namespace timing {
 
 UHAL_REGISTER_DERIVED_NODE(MasterNode)
 
+//-----------------------------------------------------------------------------
+const uint32_t MasterNode::kFLCmdBurstBatchSize = 256; // NOLINT(build/unsigned)
+const uint32_t MasterNode::kUpstreamSettleTimeout = 600; // NOLINT(build/unsigned)
+const uint32_t MasterNode::kUpstreamResetInterval = 100; // NOLINT(build/unsigned)
+const int64_t MasterNode::kDefaultAsyncReplyLatency = 50;
+const int64_t MasterNode::kMinAsyncPollInterval = 5;
+const int64_t MasterNode::kMaxAsyncPollInterval = 50;
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 MasterNode::MasterNode(const uhal::Node& node)
   : MasterNodeInterface(node)
+  , m_async_reply_latency(kDefaultAsyncReplyLatency)
+{}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+MasterNode::MasterNode(const MasterNode& other)
+  : MasterNodeInterface(other)
+  , m_async_reply_latency(other.m_async_reply_latency.load())
 {}
 //-----------------------------------------------------------------------------
 
@@ -137,9 +159,52 @@ MasterNode::send_fl_cmd(uint32_t command,
                         uint32_t channel,                  // NOLINT(build/unsigned)
                         uint32_t number_of_commands) const // NOLINT(build/unsigned)
 {
-  for (uint32_t i = 0; i < number_of_commands; i++) { // NOLINT(build/unsigned)
-    getNode<FLCmdGeneratorNode>("scmd_gen").send_fl_cmd(command, channel);
-    
+  send_fl_cmd_pulses(command, channel, number_of_commands, 1, false);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+FLCmdBurstResult
+MasterNode::send_fl_cmd_burst(uint32_t command,                   // NOLINT(build/unsigned)
+                              uint32_t channel,                   // NOLINT(build/unsigned)
+                              uint32_t number_of_commands,        // NOLINT(build/unsigned)
+                              uint32_t log_sample_interval) const // NOLINT(build/unsigned)
+{
+  return send_fl_cmd_pulses(command, channel, number_of_commands, log_sample_interval, true);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+FLCmdBurstResult
+MasterNode::send_fl_cmd_pulses(uint32_t command,                   // NOLINT(build/unsigned)
+                               uint32_t channel,                   // NOLINT(build/unsigned)
+                               uint32_t number_of_commands,        // NOLINT(build/unsigned)
+                               uint32_t log_sample_interval,       // NOLINT(build/unsigned)
+                               bool read_counters) const
+{
+  const FLCmdGeneratorNode& scmd_gen = getNode<FLCmdGeneratorNode>("scmd_gen");
+
+  scmd_gen.select_fl_cmd(command, channel, false);
+  std::pair<uhal::ValVector<uint32_t>, uhal::ValVector<uint32_t>> counters_before; // NOLINT(build/unsigned)
+  if (read_counters)
+    counters_before = scmd_gen.read_counters(false);
+  getClient().dispatch();
+
+  auto start = std::chrono::steady_clock::now();
+
+  uint32_t sent = 0; // NOLINT(build/unsigned)
+  while (sent < number_of_commands) {
+    uint32_t batch_size = std::min(kFLCmdBurstBatchSize, number_of_commands - sent); // NOLINT(build/unsigned)
+    if (log_sample_interval)
+      batch_size = std::min(batch_size, log_sample_interval - sent % log_sample_interval);
+
+    scmd_gen.queue_fl_cmd_pulses(batch_size);
+    getClient().dispatch();
+    sent += batch_size;
+
+    if (!log_sample_interval || sent % log_sample_interval)
+      continue;
+
     auto ts_l = getNode("cmd_log.tstamp_l").read();
     auto ts_h = getNode("cmd_log.tstamp_h").read();
     auto sent_cmd = getNode("cmd_log.cmd").read();
@@ -154,6 +219,35 @@ MasterNode::send_fl_cmd(uint32_t command,
     TLOG() << "Command sent " << "(" << format_reg_value(command) << ") from generator "
          << format_reg_value(channel) << " @time " << std::hex << std::showbase << timestamp;
   }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  FLCmdBurstResult result;
+  result.sent = sent;
+  result.accepted = 0;
+  result.rejected = 0;
+  result.dropped = 0;
+  result.rate_hz = elapsed.count() > 0. ? sent / elapsed.count() : 0.;
+
+  if (!read_counters)
+    return result;
+
+  auto counters_after = scmd_gen.read_counters();
+  result.accepted = counters_after.first.at(channel) - counters_before.first.at(channel);
+  result.rejected = counters_after.second.at(channel) - counters_before.second.at(channel);
+  // rejected commands are counted by the generator, the rest went missing
+  uint64_t counted = static_cast<uint64_t>(result.accepted) + result.rejected; // NOLINT(build/unsigned)
+  result.dropped = sent > counted ? sent - counted : 0;
+
+  if (number_of_commands > 1) {
+    TLOG() << "Sent " << std::dec << sent << " commands (" << format_reg_value(command) << ") from generator "
+           << format_reg_value(channel) << " at " << result.rate_hz << " Hz, accepted: " << result.accepted
+           << ", rejected: " << result.rejected;
+  }
+  if (result.dropped)
+    ers::warning(FixedLengthCommandsDropped(ERS_HERE, result.dropped, sent));
+
+  return result;
 }
 //-----------------------------------------------------------------------------
 
@@ -288,22 +382,21 @@ MasterNode::apply_endpoint_delay(uint32_t address,      // NOLINT(build/unsigned
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-void
+TimestampSyncResult
 MasterNode::sync_timestamp(uint32_t clock_frequency_hz) const // NOLINT(build/unsigned)
 {
   const uint64_t old_timestamp = read_timestamp(); // NOLINT(build/unsigned)
   TLOG() << "Reading old timestamp: " << format_reg_value(old_timestamp) << ", " << format_timestamp(old_timestamp, clock_frequency_hz);
 
-  const uint64_t now_timestamp = get_seconds_since_epoch() * clock_frequency_hz; // NOLINT(build/unsigned)
-  TLOG() << "Setting new timestamp: " << format_reg_value(now_timestamp) << ", " << format_timestamp(now_timestamp, clock_frequency_hz);
-
-  set_timestamp(now_timestamp);
+  auto result = getNode<TimestampGeneratorNode>("tstamp").sync_timestamp(clock_frequency_hz);
 
   const uint64_t new_timestamp = read_timestamp(); // NOLINT(build/unsigned)
   TLOG() << "Reading new timestamp: " << format_reg_value(new_timestamp) << ", " << format_timestamp(new_timestamp, clock_frequency_hz);
 
   enable_timestamp_broadcast();
   TLOG() << "Timestamp broadcast enabled";
+
+  return result;
 }
 //-----------------------------------------------------------------------------
 
@@ -327,7 +420,9 @@ MasterNode::set_timestamp(uint64_t timestamp) const // NOLINT(build/unsigned)
 void
 MasterNode::get_info(timingfirmwareinfo::MasterMonitorData& mon_data) const
 {
-  mon_data.timestamp = read_timestamp();
+  auto decoder = queue_monitor_data();
+  getClient().dispatch();
+  decoder(mon_data);
 }
 //-----------------------------------------------------------------------------
 
@@ -335,41 +430,62 @@ MasterNode::get_info(timingfirmwareinfo::MasterMonitorData& mon_data) const
 void
 MasterNode::get_info(opmonlib::InfoCollector& ic, int level) const
 {
-  timingfirmwareinfo::MasterMonitorData mon_data;
-  this->get_info(mon_data);
-
-  auto control = read_sub_nodes(getNode("global.csr.ctrl"), false);
-  auto state = read_sub_nodes(getNode("global.csr.stat"), false);
-  getClient().dispatch();
-
-  mon_data.ts_en = control.at("ts_en").value();
-  mon_data.ts_err = state.at("ts_err").value();
-  mon_data.tx_err = state.at("tx_err").value();
-  mon_data.ctrs_rdy = state.at("ctrs_rdy").value();
+  collect_info(ic, level);
+}
+//-----------------------------------------------------------------------------
 
-  ic.add(mon_data);
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+MasterNode::queue_info(int level) const
+{
+  auto decoder = queue_monitor_data();
 
   uint number_of_commands = 0xff;
 
   getNode("cmd_ctrs.addr").write(0x0);
   auto counters = getNode("cmd_ctrs.data").readBlock(number_of_commands);
-  getClient().dispatch();
 
-  for (uint i = 0; i < number_of_commands; ++i) { // NOLINT(build/unsigned)
+  auto scmd_gen_decoder = getNode<FLCmdGeneratorNode>("scmd_gen").queue_info(level);
 
-    timingfirmwareinfo::SentCommandCounter cmd_counter;
-    opmonlib::InfoCollector cmd_counter_ic;
+  return [decoder, number_of_commands, counters, scmd_gen_decoder](opmonlib::InfoCollector& ic) {
+    timingfirmwareinfo::MasterMonitorData mon_data;
+    decoder(mon_data);
+    ic.add(mon_data);
 
-    cmd_counter.counts = counters.at(i);
+    for (uint i = 0; i < number_of_commands; ++i) { // NOLINT(build/unsigned)
 
-    std::stringstream channel;
-    channel << "cmd_0x" << std::hex << i;
+      timingfirmwareinfo::SentCommandCounter cmd_counter;
+      opmonlib::InfoCollector cmd_counter_ic;
 
-    cmd_counter_ic.add(cmd_counter);
-    ic.add(channel.str(), cmd_counter_ic);
-  }
+      cmd_counter.counts = counters.at(i);
+
+      std::stringstream channel;
+      channel << "cmd_0x" << std::hex << i;
+
+      cmd_counter_ic.add(cmd_counter);
+      ic.add(channel.str(), cmd_counter_ic);
+    }
 
-  getNode<FLCmdGeneratorNode>("scmd_gen").get_info(ic, level);
+    scmd_gen_decoder(ic);
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::function<void(timingfirmwareinfo::MasterMonitorData&)>
+MasterNode::queue_monitor_data() const
+{
+  auto timestamp = getNode<TimestampGeneratorNode>("tstamp").read_raw_timestamp(false);
+  auto control = read_sub_nodes(getNode("global.csr.ctrl"), false);
+  auto state = read_sub_nodes(getNode("global.csr.stat"), false);
+
+  return [timestamp, control, state](timingfirmwareinfo::MasterMonitorData& mon_data) {
+    mon_data.timestamp = tstamp2int(timestamp);
+    mon_data.ts_en = control.at("ts_en").value();
+    mon_data.ts_err = state.at("ts_err").value();
+    mon_data.tx_err = state.at("tx_err").value();
+    mon_data.ctrs_rdy = state.at("ctrs_rdy").value();
+  };
 }
 //-----------------------------------------------------------------------------
 
@@ -387,12 +503,11 @@ MasterNode::transmit_async_packet(const std::vector<uint32_t>& packet, int timeo
 {
   // TODO: check for valid packet
 
-  reset_sub_nodes(getNode("acmd_buf.txbuf"));
-
   TLOG_DEBUG(11) << "tx packet: ";
   for (auto t : packet)
     TLOG_DEBUG(11) << std::hex << "0x" << t;
 
+  // txbuf is a port without sub nodes, the packet goes in a single block write
   getNode("acmd_buf.txbuf").writeBlock(packet);
   getClient().dispatch();
 
@@ -407,9 +522,19 @@ MasterNode::transmit_async_packet(const std::vector<uint32_t>& packet, int timeo
   uhal::ValWord<uint32_t> buffer_timeout;  // NOLINT(build/unsigned)
 
   // start time counting
-  auto start = std::chrono::high_resolution_clock::now();
+  auto start = std::chrono::steady_clock::now();
+  auto us_since_start = [&start]() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  // no point polling before the reply is expected
+  int64_t reply_latency = m_async_reply_latency.load();
+  if (reply_latency > 0)
+    std::this_thread::sleep_for(std::chrono::microseconds(std::min<int64_t>(reply_latency, timeout)));
 
   // Wait for the buffer to be happy
+  int64_t poll_start = us_since_start();
+  bool first_poll = true;
   while (true) {
 
     buffer_ready = getNode("acmd_buf.stat.ready").read();
@@ -424,15 +549,28 @@ MasterNode::transmit_async_packet(const std::vector<uint32_t>& packet, int timeo
     if (buffer_ready)
       break;
 
-    auto now = std::chrono::high_resolution_clock::now();
-    auto us_since_start = std::chrono::duration_cast<std::chrono::microseconds>(now - start);
-
-    if (us_since_start.count() > timeout)
+    int64_t elapsed = us_since_start();
+    if (elapsed > timeout)
       throw VLCommandReplyBufferFlagTimeout(ERS_HERE, timeout);
 
-    std::this_thread::sleep_for(std::chrono::microseconds(50));
+    // late reply, poll at a fraction of the expected latency
+    int64_t wait = std::clamp(reply_latency / 4, kMinAsyncPollInterval, kMaxAsyncPollInterval);
+    std::this_thread::sleep_for(std::chrono::microseconds(std::min<int64_t>(wait, timeout - elapsed)));
+    poll_start = us_since_start();
+    first_poll = false;
   }
-    
+
+  if (first_poll) {
+    // the reply was there before the first poll, so it may well come sooner: try a shorter sleep next time
+    reply_latency -= reply_latency / 8;
+  } else {
+    // the start of the poll that found the reply: sleeping that long next time makes a single poll enough
+    reply_latency = (3 * reply_latency + poll_start) / 4;
+  }
+  m_async_reply_latency = reply_latency;
+  TLOG_DEBUG(10) << "async reply after " << us_since_start() << " us, latency estimate: " << reply_latency << " us";
+
+  // rxbuf is a port, reading it advances the firmware pointer: only read it once the reply is complete
   auto rx_packet = getNode("acmd_buf.rxbuf").readBlock(0x20);
   getClient().dispatch();
 
@@ -512,7 +650,7 @@ MasterNode::read_endpoint_data(uint16_t endpoint_address, uint8_t reg_address, u
 void MasterNode::disable_timestamp_broadcast() const
 {
   getNode("global.csr.ctrl.ts_en").write(0x0);
-  getClient().dispatch();
+  dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -520,7 +658,7 @@ void MasterNode::disable_timestamp_broadcast() const
 void MasterNode::enable_timestamp_broadcast() const
 {
   getNode("global.csr.ctrl.ts_en").write(0x1);
-  getClient().dispatch();
+  dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -528,73 +666,178 @@ void MasterNode::enable_timestamp_broadcast() const
 timingfirmware::EndpointCheckResult
 MasterNode::scan_endpoint(uint16_t endpoint_address, bool control_sfp) const
 {
-  timingfirmware::EndpointCheckResult result;
-  auto global = getNode<MasterGlobalNode>("global");
+  return scan_endpoints({ endpoint_address }, control_sfp).at(0);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+timingfirmware::EndpointCheckResultoVector
+MasterNode::scan_endpoints(const std::vector<uint16_t>& endpoint_addresses, bool control_sfp) const // NOLINT(build/unsigned)
+{
   auto echo = getNode<EchoMonitorNode>("echo_mon");
 
-  timingfirmware::EndpointCheckResult endpoint_result;
-  endpoint_result.address = endpoint_address;
+  timingfirmware::EndpointCheckResultoVector results;
+  std::vector<size_t> delayed_endpoints;
 
-  // is endpoint sfp switched on?
-  // are any relevant muxes set to correct channel?
-  if (control_sfp)
-  {
-    switch_endpoint_sfp(endpoint_address, true);
+  auto read_state_after_delay = [this, &echo](timingfirmware::EndpointCheckResult& endpoint_result) {
+    uint16_t endpoint_address = endpoint_result.address; // NOLINT(build/unsigned)
 
-    millisleep(100);
-  }
+    auto ept_state_after_delays = read_endpoint_data(endpoint_address, 0x71, 0x1, 0x1).at(0) & 0xf;
+    TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << ", state after delays apply: " << ept_state_after_delays;
+    endpoint_result.state_after_delay_apply = ept_state_after_delays;
 
-  try
-  {
-    global.enable_upstream_endpoint();
-  }
-  catch (const timing::ReceiverNotReady& e)
-  {
+    endpoint_result.round_trip_time_after_delay_apply = echo.send_echo_and_measure_delay();
+    TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << ", RTT after delays apply: " << endpoint_result.round_trip_time_after_delay_apply;
+  };
+
+  // the SFP goes off after each endpoint whatever happened, and a failure to do so only ends that endpoint
+  auto switch_sfp_off = [this, control_sfp](uint16_t endpoint_address) { // NOLINT(build/unsigned)
+    if (!control_sfp)
+      return;
+    try
+    {
       switch_endpoint_sfp(endpoint_address, false);
+    }
+    catch (const std::exception& e)
+    {
+      ers::error(EndpointScanFailed(ERS_HERE, endpoint_address, e));
+    }
+  };
 
-      ers::error(MonitoredEndpointDead(ERS_HERE, endpoint_address));
+  // first pass: measure every endpoint, sending the delays to those needing them without waiting for them to relock
+  for (auto endpoint_address : endpoint_addresses)
+  {
+    timingfirmware::EndpointCheckResult endpoint_result;
+    endpoint_result.address = endpoint_address;
 
-      return endpoint_result;
-  }
+    // one faulty endpoint should not stop the scan of the others
+    try
+    {
+      if (!connect_upstream_endpoint(endpoint_address, control_sfp))
+      {
+        ers::error(MonitoredEndpointDead(ERS_HERE, endpoint_address));
+        results.push_back(endpoint_result);
+        continue;
+      }
+
+      endpoint_result.alive = true;
+      endpoint_result.round_trip_time = echo.send_echo_and_measure_delay();
+      TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << " alive. RTT: " << endpoint_result.round_trip_time;
+
+      auto ept_state = read_endpoint_data(endpoint_address, 0x71, 0x1, 0x1).at(0) & 0xf;
+      TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << " state: 0x" << std::hex << ept_state;
+      endpoint_result.state = ept_state;
 
-  endpoint_result.alive = true;
-  endpoint_result.round_trip_time = echo.send_echo_and_measure_delay();
-  TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << " alive. RTT: " << endpoint_result.round_trip_time;
+      if (ept_state == 0x6)
+      {
+        TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << ", applying delays of: " << 0x0;
+        apply_endpoint_delay(endpoint_address, 0x0, 0x0, 0x0, false, false);
+        endpoint_result.applied_delay = 0x0;
+
+        // with no other endpoint to measure meanwhile, cycling the SFP again would gain nothing
+        if (endpoint_addresses.size() == 1)
+          read_state_after_delay(endpoint_result);
+        else
+          delayed_endpoints.push_back(results.size());
+      }
+      else if (ept_state == 0x7 || ept_state == 0x8)
+      {
+        TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << ", delays not needed";
+      }
+      else
+      {
+        ers::error(MonitoredEndpointUnexpectedState(ERS_HERE, endpoint_address, ept_state));
+      }
+    }
+    catch (const ers::Issue& e)
+    {
+      ers::error(e);
+    }
+    catch (const std::exception& e)
+    {
+      ers::error(EndpointScanFailed(ERS_HERE, endpoint_address, e));
+    }
 
-  auto ept_state = read_endpoint_data(endpoint_address, 0x71, 0x1, 0x1).at(0) & 0xf;
-  TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << " state: 0x" << std::hex << ept_state;
-  endpoint_result.state = ept_state;
+    switch_sfp_off(endpoint_address);
+    results.push_back(endpoint_result);
+  }
 
-  if (ept_state == 0x6)
+  // second pass: the endpoints given delays have relocked while the others were measured
+  for (auto index : delayed_endpoints)
   {
-    TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << ", applying delays of: " << 0x0;
-      
-    apply_endpoint_delay(endpoint_address, 0x0, 0x0, 0x0, false, false);
-      
-    endpoint_result.applied_delay = 0x0;
+    auto& endpoint_result = results.at(index);
+    uint16_t endpoint_address = endpoint_result.address; // NOLINT(build/unsigned)
 
-    auto ept_state_after_delays = read_endpoint_data(endpoint_address, 0x71, 0x1, 0x1).at(0) & 0xf;
-    TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << ", state after delays apply: " << ept_state_after_delays;
-    endpoint_result.state_after_delay_apply = ept_state_after_delays;
+    try
+    {
+      if (!connect_upstream_endpoint(endpoint_address, control_sfp))
+      {
+        ers::error(MonitoredEndpointDead(ERS_HERE, endpoint_address));
+        continue;
+      }
 
-    endpoint_result.round_trip_time_after_delay_apply = echo.send_echo_and_measure_delay();
-    TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << ", RTT after delays apply: " << endpoint_result.round_trip_time_after_delay_apply;
+      read_state_after_delay(endpoint_result);
+    }
+    catch (const ers::Issue& e)
+    {
+      ers::error(e);
+    }
+    catch (const std::exception& e)
+    {
+      ers::error(EndpointScanFailed(ERS_HERE, endpoint_address, e));
+    }
+
+    switch_sfp_off(endpoint_address);
   }
-  else if (ept_state == 0x7 || ept_state == 0x8)
+
+  return results;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+bool
+MasterNode::connect_upstream_endpoint(uint16_t endpoint_address, bool control_sfp) const // NOLINT(build/unsigned)
+{
+  auto global = getNode<MasterGlobalNode>("global");
+
+  if (control_sfp)
+    switch_endpoint_sfp(endpoint_address, true);
+
+  // pulse the receiver reset every kUpstreamResetInterval until it locks: the first pulses may come
+  // before the endpoint transmitter is up, and a reset into no signal can leave the receiver unlocked
+  auto start = std::chrono::steady_clock::now();
+  try
   {
-    TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << ", delays not needed";
+    while (true)
+    {
+      global.reset_upstream_receiver();
+      try
+      {
+        global.wait_for_upstream_receiver(kUpstreamResetInterval);
+        return true;
+      }
+      catch (const timing::ReceiverNotReady& e)
+      {
+        auto ms_since_start =
+          std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        if (ms_since_start.count() > kUpstreamSettleTimeout)
+        {
+          TLOG_DEBUG(5) << "Endpoint at address " << endpoint_address << " did not connect: " << e.what();
+          break;
+        }
+      }
+    }
   }
-  else
+  catch (const std::exception&)
   {
-    ers::error(MonitoredEndpointUnexpectedState(ERS_HERE, endpoint_address, ept_state));
+    if (control_sfp)
+      switch_endpoint_sfp(endpoint_address, false);
+    throw;
   }
 
   if (control_sfp)
-  {
     switch_endpoint_sfp(endpoint_address, false);
-  }
-
-  return endpoint_result;
+  return false;
 }
 //-----------------------------------------------------------------------------
 
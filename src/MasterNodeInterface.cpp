@@ -36,6 +36,17 @@ MasterNodeInterface::apply_endpoint_delay(const ActiveEndpointConfig& ept_config
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+timingfirmware::EndpointCheckResultoVector
+MasterNodeInterface::scan_endpoints(const std::vector<uint16_t>& endpoint_addresses, bool control_sfp) const // NOLINT(build/unsigned)
+{
+  timingfirmware::EndpointCheckResultoVector results;
+  for (auto address : endpoint_addresses)
+    results.push_back(scan_endpoint(address, control_sfp));
+  return results;
+}
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 void
 MasterNodeInterface::enable_periodic_fl_cmd(uint32_t channel, double rate, bool poisson, uint32_t clock_frequency_hz) const // NOLINT(build/unsigned)
@@ -63,17 +63,14 @@ OuroborosMuxDesign::configure() const
 void
 OuroborosMuxDesign::get_info(opmonlib::InfoCollector& ci, int level) const
 { 
-  opmonlib::InfoCollector master_collector;
-  get_master_node_plain()->get_info(master_collector, level);
-  ci.add("master", master_collector);
+  auto master_decoder = get_master_node_plain()->queue_info(level);
+  auto io_decoder = get_io_node_plain()->queue_info(level);
+  auto endpoint_decoder = this->get_endpoint_node_plain(0)->queue_info(level);
+  getClient().dispatch();
 
-  opmonlib::InfoCollector hardware_collector;
-  get_io_node_plain()->get_info(hardware_collector, level);
-  ci.add("io", hardware_collector);
-
-  opmonlib::InfoCollector endpoint_collector;
-  this->get_endpoint_node_plain(0)->get_info(endpoint_collector, level);
-  ci.add("endpoint", endpoint_collector);
+  decode_info(ci, "master", master_decoder);
+  decode_info(ci, "io", io_decoder);
+  decode_info(ci, "endpoint", endpoint_decoder);
 }
 //-----------------------------------------------------------------------------
 } // namespace dunedaq::timing  
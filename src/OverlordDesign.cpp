@@ -57,12 +57,17 @@ OverlordDesign::configure() const
   // Set timestamp to current time
   sync_timestamp();
 
+  // Spill and trigger interface configuration go out in a single dispatch
+  DeferredDispatchScope deferred_dispatch(*this);
+
   // Enable spill interface
   get_master_node<PDIMasterNode>()->enable_spill_interface();
 
   // Trigger interface configuration
   reset_external_triggers_endpoint();
   enable_external_triggers();
+
+  deferred_dispatch.flush();
 }
 //-----------------------------------------------------------------------------
 
@@ -70,13 +75,12 @@ OverlordDesign::configure() const
 void
 OverlordDesign::get_info(opmonlib::InfoCollector& ci, int level) const
 { 
-  opmonlib::InfoCollector master_collector;
-  get_master_node_plain()->get_info(master_collector, level);
-  ci.add("master", master_collector);
+  auto master_decoder = get_master_node_plain()->queue_info(level);
+  auto io_decoder = get_io_node_plain()->queue_info(level);
+  getClient().dispatch();
 
-  opmonlib::InfoCollector hardware_collector;
-  get_io_node_plain()->get_info(hardware_collector, level);
-  ci.add("io", hardware_collector);
+  decode_info(ci, "master", master_decoder);
+  decode_info(ci, "io", io_decoder);
 
   // TODO full trix info
   //auto trig_interface_enabled = uhal::Node::getNode("trig_rx.csr.ctrl.ext_trig_en").read();
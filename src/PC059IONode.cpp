@@ -11,6 +11,7 @@
 #include "logging/Logging.hpp"
 
 #include <string>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
@@ -24,7 +25,10 @@ PC059IONode::PC059IONode(const uhal::Node& node)
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-PC059IONode::~PC059IONode() {}
+PC059IONode::~PC059IONode()
+{
+  stop_i2c_info_sampler();
+}
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
@@ -51,17 +55,20 @@ PC059IONode::get_status(bool print_out) const
 
 //-----------------------------------------------------------------------------
 void
-PC059IONode::reset(int32_t fanout_mode, const std::string& clock_config_file) const
+PC059IONode::reset(int32_t fanout_mode, const std::string& clock_config_file, bool warm_restart) const
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
 
   // Soft reset
   write_soft_reset_register();
 
   millisleep(1000);
 
-  // Reset PLL and I2C
-  getNode("csr.ctrl.pll_rst").write(0x1);
-  getNode("csr.ctrl.pll_rst").write(0x0);
+  // Reset PLL, unless it is kept running, and I2C
+  if (!warm_restart) {
+    getNode("csr.ctrl.pll_rst").write(0x1);
+    getNode("csr.ctrl.pll_rst").write(0x0);
+  }
 
   getNode("csr.ctrl.rst_i2c").write(0x1);
   getNode("csr.ctrl.rst_i2c").write(0x0);
@@ -71,6 +78,9 @@ PC059IONode::reset(int32_t fanout_mode, const std::string& clock_config_file) co
 
   getClient().dispatch();
 
+  invalidate_i2c_core_states();
+  get_i2c_device<I2C9546SwitchSlave>(m_pll_i2c_bus, "SFP_Switch")->invalidate_channels_states();
+
   // enclustra i2c switch stuff
   try {
     getNode<I2CMasterNode>(m_uid_i2c_bus).get_slave("AX3_Switch").write_i2c(0x01, 0x7f);
@@ -83,7 +93,7 @@ PC059IONode::reset(int32_t fanout_mode, const std::string& clock_config_file) co
   TLOG() << "PLL configuration file : " << clock_config_path;
 
   // Upload config file to PLL
-  configure_pll(clock_config_path);
+  configure_pll(clock_config_path, warm_restart);
 
   // Reset mmcm
   getNode("csr.ctrl.rst").write(0x1);
@@ -95,16 +105,9 @@ PC059IONode::reset(int32_t fanout_mode, const std::string& clock_config_file) co
 
   auto sfp_expander = get_i2c_device<I2CExpanderSlave>(m_uid_i2c_bus, "SFPExpander");
 
-  // Set invert registers to default for both banks
-  sfp_expander->set_inversion(0, 0x00);
-  sfp_expander->set_inversion(1, 0x00);
-
-  // Bank 0 input, bank 1 output
-  sfp_expander->set_io(0, 0x00);
-  sfp_expander->set_io(1, 0xff);
-
-  // Bank 0 - enable all SFPGs (enable low)
-  sfp_expander->set_outputs(0, 0x00);
+  // Invert registers to default for both banks
+  // Bank 0 output - enable all SFPGs (enable low), bank 1 input
+  sfp_expander->configure({ 0x00, 0x00, 0x00 }, { 0x00, 0xff, 0xff });
   TLOG_DEBUG(0) << "SFPs 0-7 enabled";
 
   // To be removed from firmware address maps also
@@ -118,9 +121,9 @@ PC059IONode::reset(int32_t fanout_mode, const std::string& clock_config_file) co
 
 //-----------------------------------------------------------------------------
 void
-PC059IONode::reset(const std::string& clock_config_file) const
+PC059IONode::reset(const std::string& clock_config_file, bool warm_restart) const
 {
-  reset(-1, clock_config_file);
+  reset(-1, clock_config_file, warm_restart);
 }
 //-----------------------------------------------------------------------------
 
@@ -149,16 +152,35 @@ PC059IONode::read_active_downstream_mux_channel() const
 void
 PC059IONode::switch_sfp_i2c_mux_channel(uint32_t sfp_id) const // NOLINT(build/unsigned)
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
+
+  auto sfp_switch = get_i2c_device<I2C9546SwitchSlave>(m_pll_i2c_bus, "SFP_Switch");
+  uint8_t channel_select_byte = 1UL << sfp_id; // NOLINT(build/unsigned)
 
+  try {
+    if (!sfp_switch->select_channels(channel_select_byte))
+      return;
+  } catch (const I2CException& e) {
+    TLOG_DEBUG(3) << "PC059 SFP I2C mux switch failed, resetting the mux";
+    reset_sfp_i2c_mux();
+    sfp_switch->select_channels(channel_select_byte, true);
+  }
+  TLOG_DEBUG(3) << "PC059 SFP I2C mux set to " << format_reg_value(sfp_id);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+PC059IONode::reset_sfp_i2c_mux() const
+{
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   getNode("csr.ctrl.rst_i2cmux").write(0x1);
   getClient().dispatch();
   getNode("csr.ctrl.rst_i2cmux").write(0x0);
   getClient().dispatch();
   millisleep(100);
 
-  uint8_t channel_select_byte = 1UL << sfp_id; // NOLINT(build/unsigned)
-  getNode<I2CMasterNode>(m_pll_i2c_bus).get_slave("SFP_Switch").write_i2cPrimitive({ channel_select_byte });
-  TLOG_DEBUG(3) << "PC059 SFP I2C mux set to " << format_reg_value(sfp_id);
+  get_i2c_device<I2C9546SwitchSlave>(m_pll_i2c_bus, "SFP_Switch")->invalidate_channels_states();
 }
 //-----------------------------------------------------------------------------
 
@@ -166,6 +188,7 @@ PC059IONode::switch_sfp_i2c_mux_channel(uint32_t sfp_id) const // NOLINT(build/u
 std::string
 PC059IONode::get_sfp_status(uint32_t sfp_id, bool print_out) const // NOLINT(build/unsigned)
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   // on this board the upstream sfp has its own i2c bus, and the 8 downstream sfps are muxed onto the main i2c bus
   std::stringstream status;
   uint32_t sfp_bus_index; // NOLINT(build/unsigned)
@@ -193,6 +216,7 @@ PC059IONode::get_sfp_status(uint32_t sfp_id, bool print_out) const // NOLINT(bui
 void
 PC059IONode::switch_sfp_soft_tx_control_bit(uint32_t sfp_id, bool turn_on) const // NOLINT(build/unsigned)
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   // on this board the upstream sfp has its own i2c bus, and the 8 downstream sfps are muxed onto the main i2c bus
   uint32_t sfp_bus_index; // NOLINT(build/unsigned)
   if (sfp_id == 0) {
@@ -212,25 +236,9 @@ PC059IONode::switch_sfp_soft_tx_control_bit(uint32_t sfp_id, bool turn_on) const
 void
 PC059IONode::get_info(timinghardwareinfo::TimingPC059MonitorData& mon_data) const
 {
-  auto subnodes = read_sub_nodes(getNode("csr.stat"));
-
-  mon_data.cdr_lol = subnodes.at("cdr_lol").value();
-  mon_data.cdr_los = subnodes.at("cdr_los").value();
-  
-  mon_data.mmcm_ok = subnodes.at("mmcm_ok").value();
-  mon_data.mmcm_sticky = subnodes.at("mmcm_sticky").value();
-  
-  mon_data.pll_lol = subnodes.at("pll_lol").value();
-  mon_data.pll_ok = subnodes.at("pll_ok").value();
-  mon_data.pll_sticky = subnodes.at("pll_sticky").value();
-  
-  mon_data.sfp_los = subnodes.at("sfp_los").value();
-
-  mon_data.ucdr_lol = subnodes.at("ucdr_lol").value();
-  mon_data.ucdr_los = subnodes.at("ucdr_los").value();
-
-  mon_data.usfp_flt = subnodes.at("usfp_flt").value();
-  mon_data.usfp_los = subnodes.at("usfp_los").value();
+  auto decoder = queue_monitor_data();
+  getClient().dispatch();
+  decoder(mon_data);
 }
 //-----------------------------------------------------------------------------
 
@@ -238,52 +246,122 @@ PC059IONode::get_info(timinghardwareinfo::TimingPC059MonitorData& mon_data) cons
 void
 PC059IONode::get_info(opmonlib::InfoCollector& ci, int level) const
 {
-  if (level >= 2)
-  {
-    timinghardwareinfo::TimingPLLMonitorData pll_mon_data;
-    this->get_pll()->get_info(pll_mon_data);
-    ci.add(pll_mon_data);
+  collect_info(ci, level);
+}
+//-----------------------------------------------------------------------------
 
-    timinghardwareinfo::TimingSFPMonitorData upstream_sfp_mon_data;
-    auto upstream_sfp = get_i2c_device<I2CSFPSlave>(m_sfp_i2c_buses.at(0), "SFP_EEProm");
-    try {
-      upstream_sfp->get_info(upstream_sfp_mon_data);
-      opmonlib::InfoCollector upstream_sfp_ic;
-      upstream_sfp_ic.add(upstream_sfp_mon_data);
-      ci.add("upstream_sfp", upstream_sfp_ic);
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+PC059IONode::queue_info(int level) const
+{
+  // the I2C data is read at decode time, or taken from the background sampler
+  InfoDecoder i2c_decoder;
+  if (level >= 2) {
+    i2c_decoder = queue_i2c_info(level);
+  }
+
+  std::function<void(timinghardwareinfo::TimingPC059MonitorData&)> decoder;
+  if (level >= 1) {
+    decoder = queue_monitor_data();
+  }
+
+  return [i2c_decoder, decoder](opmonlib::InfoCollector& ci) {
+    if (i2c_decoder) {
+      i2c_decoder(ci);
     }
-    catch (timing::SFPUnreachable& e) {
-      // It is valid that an SFP may not be installed, currently no good way of knowing whether they it should be
-      TLOG_DEBUG(2) << "Failed to communicate with upstream SFP on i2c bus" << m_sfp_i2c_buses.at(0);
+    if (decoder) {
+      timinghardwareinfo::TimingPC059MonitorData mon_data;
+      decoder(mon_data);
+      ci.add(mon_data);
     }
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::function<void(timinghardwareinfo::TimingPC059MonitorData&)>
+PC059IONode::queue_monitor_data() const
+{
+  auto subnodes = read_sub_nodes(getNode("csr.stat"), false);
+
+  return [=](timinghardwareinfo::TimingPC059MonitorData& mon_data) {
+    mon_data.cdr_lol = subnodes.at("cdr_lol").value();
+    mon_data.cdr_los = subnodes.at("cdr_los").value();
+
+    mon_data.mmcm_ok = subnodes.at("mmcm_ok").value();
+    mon_data.mmcm_sticky = subnodes.at("mmcm_sticky").value();
+
+    mon_data.pll_lol = subnodes.at("pll_lol").value();
+    mon_data.pll_ok = subnodes.at("pll_ok").value();
+    mon_data.pll_sticky = subnodes.at("pll_sticky").value();
+
+    mon_data.sfp_los = subnodes.at("sfp_los").value();
+
+    mon_data.ucdr_lol = subnodes.at("ucdr_lol").value();
+    mon_data.ucdr_los = subnodes.at("ucdr_los").value();
+
+    mon_data.usfp_flt = subnodes.at("usfp_flt").value();
+    mon_data.usfp_los = subnodes.at("usfp_los").value();
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+PC059IONode::sample_i2c_info(int /*level*/) const
+{
+  timinghardwareinfo::TimingPLLMonitorData pll_mon_data;
+  this->get_pll()->get_info(pll_mon_data);
+
+  std::vector<std::pair<std::string, opmonlib::InfoCollector>> sfp_ics;
+
+  timinghardwareinfo::TimingSFPMonitorData upstream_sfp_mon_data;
+  auto upstream_sfp = get_i2c_device<I2CSFPSlave>(m_sfp_i2c_buses.at(0), "SFP_EEProm");
+  try {
+    upstream_sfp->get_info(upstream_sfp_mon_data);
+    opmonlib::InfoCollector upstream_sfp_ic;
+    upstream_sfp_ic.add(upstream_sfp_mon_data);
+    sfp_ics.push_back(std::make_pair("upstream_sfp", upstream_sfp_ic));
+  }
+  catch (timing::SFPUnreachable& e) {
+    // It is valid that an SFP may not be installed, currently no good way of knowing whether they it should be
+    TLOG_DEBUG(2) << "Failed to communicate with upstream SFP on i2c bus" << m_sfp_i2c_buses.at(0);
+  }
+
 
+  // start the sweep from the SFP the mux is already set to
+  std::vector<uint8_t> sfp_ids; // NOLINT(build/unsigned)
+  for (uint sfp_id=0; sfp_id < 8; ++sfp_id) {
+    sfp_ids.push_back(sfp_id);
+  }
+  sfp_ids = get_i2c_device<I2C9546SwitchSlave>(m_pll_i2c_bus, "SFP_Switch")->order_sweep(sfp_ids);
+
+  for (uint sfp_id : sfp_ids) {
+    TLOG_DEBUG(5) << "checking sfp: " << sfp_id;
+    switch_sfp_i2c_mux_channel(sfp_id);
+    
+    auto sfp = get_i2c_device<I2CSFPSlave>(m_sfp_i2c_buses.at(1), "SFP_EEProm");
+    timinghardwareinfo::TimingSFPMonitorData sfp_data;
 
-    for (uint sfp_id=0; sfp_id < 8; ++sfp_id) {
-      TLOG_DEBUG(5) << "checking sfp: " << sfp_id;
-      switch_sfp_i2c_mux_channel(sfp_id);
-      
-      auto sfp = get_i2c_device<I2CSFPSlave>(m_sfp_i2c_buses.at(1), "SFP_EEProm");
-      timinghardwareinfo::TimingSFPMonitorData sfp_data;
-
-      try {
-        sfp->get_info(sfp_data);
-      } catch (timing::SFPUnreachable& e) {
-        // It is valid that an SFP may not be installed, currently no good way of knowing whether they it should be
-        TLOG_DEBUG(2) << "Failed to communicate with downstream SFP: " << sfp_id << " on i2c bus" << m_sfp_i2c_buses.at(1);
-        continue;
-      }
-
-      opmonlib::InfoCollector sfp_ic;
-      sfp_ic.add(sfp_data);
-      ci.add("sfp_"+std::to_string(sfp_id), sfp_ic);
+    try {
+      sfp->get_info(sfp_data);
+    } catch (timing::SFPUnreachable& e) {
+      // It is valid that an SFP may not be installed, currently no good way of knowing whether they it should be
+      TLOG_DEBUG(2) << "Failed to communicate with downstream SFP: " << sfp_id << " on i2c bus" << m_sfp_i2c_buses.at(1);
+      continue;
     }
+
+    opmonlib::InfoCollector sfp_ic;
+    sfp_ic.add(sfp_data);
+    sfp_ics.push_back(std::make_pair("sfp_"+std::to_string(sfp_id), sfp_ic));
   }
 
-  if (level >= 1) {
-    timinghardwareinfo::TimingPC059MonitorData mon_data;
-    this->get_info(mon_data);
-    ci.add(mon_data);
-  }  
+  return [pll_mon_data, sfp_ics](opmonlib::InfoCollector& ci) {
+    ci.add(pll_mon_data);
+    for (auto sfp_ic : sfp_ics) {
+      ci.add(sfp_ic.first, sfp_ic.second);
+    }
+  };
 }
 //-----------------------------------------------------------------------------
 
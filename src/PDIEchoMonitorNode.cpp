@@ -34,13 +34,14 @@ uint64_t // NOLINT(build/unsigned)
 PDIEchoMonitorNode::send_echo_and_measure_delay(int64_t timeout) const
 {
 
-  getNode("csr.ctrl.go").write(0x1);
+  m_registers.get(*this, kCtrlGo).write(0x1);
   getClient().dispatch();
 
   auto start = std::chrono::high_resolution_clock::now();
 
   std::chrono::milliseconds ms_since_start(0);
 
+  const uhal::Node& rx_done_node = m_registers.get(*this, kStatRxDone);
   uhal::ValWord<uint32_t> done; // NOLINT(build/unsigned)
 
   while (ms_since_start.count() < timeout) {
@@ -50,7 +51,7 @@ PDIEchoMonitorNode::send_echo_and_measure_delay(int64_t timeout) const
 
     millisleep(100);
 
-    done = getNode("csr.stat.rx_done").read();
+    done = rx_done_node.read();
     getClient().dispatch();
 
     TLOG_DEBUG(0) << "rx done: " << std::hex << done.value();
@@ -93,24 +93,46 @@ PDIHSIEndpointNode::get_status(bool print_out) const
 void
 PDIHSIEndpointNode::get_info(timingendpointinfo::TimingEndpointInfo& mon_data) const
 {
-  auto endpoint_control = read_sub_nodes(getNode("csr.ctrl"), false);
-  auto endpoint_state = read_sub_nodes(getNode("csr.stat"), false);
+  auto decoder = queue_monitor_data();
   getClient().dispatch();
-
-  mon_data.state = endpoint_state.at("ep_stat").value();
-  mon_data.ready = endpoint_state.at("ep_rdy").value();
-  mon_data.partition = endpoint_control.at("tgrp").value();
-  mon_data.address = endpoint_control.at("addr").value();
+  decoder(mon_data);
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 void
-PDIHSIEndpointNode::get_info(opmonlib::InfoCollector& ci, int /*level*/) const
+PDIHSIEndpointNode::get_info(opmonlib::InfoCollector& ci, int level) const
+{
+  collect_info(ci, level);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+PDIHSIEndpointNode::queue_info(int /*level*/) const
 {
-  timingendpointinfo::TimingEndpointInfo mon_data;
-  this->get_info(mon_data);
-  ci.add(mon_data);
+  auto decoder = queue_monitor_data();
+  return [decoder](opmonlib::InfoCollector& ci) {
+    timingendpointinfo::TimingEndpointInfo mon_data;
+    decoder(mon_data);
+    ci.add(mon_data);
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::function<void(timingendpointinfo::TimingEndpointInfo&)>
+PDIHSIEndpointNode::queue_monitor_data() const
+{
+  auto endpoint_control = read_sub_nodes(getNode("csr.ctrl"), false);
+  auto endpoint_state = read_sub_nodes(getNode("csr.stat"), false);
+
+  return [=](timingendpointinfo::TimingEndpointInfo& mon_data) {
+    mon_data.state = endpoint_state.at("ep_stat").value();
+    mon_data.ready = endpoint_state.at("ep_rdy").value();
+    mon_data.partition = endpoint_control.at("tgrp").value();
+    mon_data.address = endpoint_control.at("addr").value();
+  };
 }
 //-----------------------------------------------------------------------------
 
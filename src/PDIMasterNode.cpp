@@ -59,19 +59,18 @@ PDIMasterNode::set_timestamp(uint64_t timestamp) const // NOLINT(build/unsigned)
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-void
+TimestampSyncResult
 PDIMasterNode::sync_timestamp(uint32_t clock_frequency_hz) const // NOLINT(build/unsigned)
 {
   const uint64_t old_timestamp = read_timestamp(); // NOLINT(build/unsigned)
   TLOG() << "Reading old timestamp: " << format_reg_value(old_timestamp) << ", " << format_timestamp(old_timestamp, clock_frequency_hz);
 
-  const uint64_t now_timestamp = get_seconds_since_epoch() * clock_frequency_hz; // NOLINT(build/unsigned)
-  TLOG() << "Setting new timestamp: " << format_reg_value(now_timestamp) << ", " << format_timestamp(now_timestamp, clock_frequency_hz);
-
-  set_timestamp(now_timestamp);
+  auto result = getNode<TimestampGeneratorNode>("tstamp").sync_timestamp(clock_frequency_hz);
 
   const uint64_t new_timestamp = read_timestamp(); // NOLINT(build/unsigned)
   TLOG() << "Reading new timestamp: " << format_reg_value(new_timestamp) << ", " << format_timestamp(new_timestamp, clock_frequency_hz);
+
+  return result;
 }
 //-----------------------------------------------------------------------------
 
@@ -237,8 +236,9 @@ PDIMasterNode::read_in_spill() const
 void
 PDIMasterNode::get_info(timingfirmwareinfo::PDIMasterMonitorData& mon_data) const
 {
-  auto timestamp = getNode<TimestampGeneratorNode>("tstamp").read_raw_timestamp();
-  mon_data.timestamp = tstamp2int(timestamp);
+  auto decoder = queue_monitor_data();
+  getClient().dispatch();
+  decoder(mon_data);
 }
 //-----------------------------------------------------------------------------
 
@@ -246,20 +246,51 @@ PDIMasterNode::get_info(timingfirmwareinfo::PDIMasterMonitorData& mon_data) cons
 void
 PDIMasterNode::get_info(opmonlib::InfoCollector& ic, int level) const
 {
-  timingfirmwareinfo::PDIMasterMonitorData mon_data;
-  this->get_info(mon_data);
-  ic.add(mon_data);
+  collect_info(ic, level);
+}
+//-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+PDIMasterNode::queue_info(int level) const
+{
+  auto decoder = queue_monitor_data();
+
+  std::vector<InfoDecoder> partition_decoders;
   for (int i=0; i < 4; ++i)
   {
-    opmonlib::InfoCollector partition_ic;
-    get_partition_node(i).get_info(partition_ic, level);
-    ic.add("partition"+std::to_string(i),partition_ic);
+    partition_decoders.push_back(get_partition_node(i).queue_info(level));
   }
 
-  getNode<FLCmdGeneratorNode>("scmd_gen").get_info(ic, level);
+  auto scmd_gen_decoder = getNode<FLCmdGeneratorNode>("scmd_gen").queue_info(level);
+  auto spill_decoder = getNode<SpillInterfaceNode>("spill").queue_info(level);
+
+  return [decoder, partition_decoders, scmd_gen_decoder, spill_decoder](opmonlib::InfoCollector& ic) {
+    timingfirmwareinfo::PDIMasterMonitorData mon_data;
+    decoder(mon_data);
+    ic.add(mon_data);
+
+    for (size_t i=0; i < partition_decoders.size(); ++i)
+    {
+      decode_info(ic, "partition"+std::to_string(i), partition_decoders.at(i));
+    }
+
+    scmd_gen_decoder(ic);
+
+    spill_decoder(ic);
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::function<void(timingfirmwareinfo::PDIMasterMonitorData&)>
+PDIMasterNode::queue_monitor_data() const
+{
+  auto timestamp = getNode<TimestampGeneratorNode>("tstamp").read_raw_timestamp(false);
 
-  getNode<SpillInterfaceNode>("spill").get_info(ic, level);
+  return [timestamp](timingfirmwareinfo::PDIMasterMonitorData& mon_data) {
+    mon_data.timestamp = tstamp2int(timestamp);
+  };
 }
 //-----------------------------------------------------------------------------
 
@@ -0,0 +1,152 @@
+/**
+ * @file PartitionEventStream.cpp
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/PartitionEventStream.hpp"
+
+#include "timing/TimingIssues.hpp"
+#include "timing/toolbox.hpp"
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+//-----------------------------------------------------------------------------
+const size_t PartitionEventStream::kDefaultEventsPerFetch = 1024;
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+PartitionEventStream::PartitionEventStream(const PartitionNode& partition, size_t max_events_per_fetch)
+  : m_partition(partition)
+  , m_max_events_per_fetch(std::max<size_t>(max_events_per_fetch, 1))
+  , m_capture_writer(nullptr)
+  , m_previous_state{ 0, false, false }
+  , m_current(0)
+  , m_position(0)
+  , m_event_count(0)
+  , m_fetch_count(0)
+  , m_buffer_warnings(0)
+  , m_buffer_errors(0)
+{
+  for (auto& buffer : m_buffers)
+    buffer.reserve(m_max_events_per_fetch * PartitionNode::kWordsPerEvent);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+PartitionEventStream::set_capture_writer(EventCaptureWriter* writer)
+{
+  if (writer && writer->get_stream_type() != EventCapture::kPartitionStream)
+    throw EventCaptureError(ERS_HERE, writer->get_path(), "not a partition capture");
+
+  m_capture_writer = writer;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+const uint32_t* // NOLINT(build/unsigned)
+PartitionEventStream::next()
+{
+  if (m_position == m_buffers[m_current].size() && !fetch())
+    return nullptr;
+
+  const uint32_t* event = m_buffers[m_current].data() + m_position; // NOLINT(build/unsigned)
+  m_position += PartitionNode::kWordsPerEvent;
+  return event;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+size_t
+PartitionEventStream::fetch()
+{
+  // a count of less than one event from the previous fetch says nothing about the events that arrived since,
+  // e.g. when iterating again after the stream ran empty: read it again
+  if (m_buffer_state && m_buffer_state().word_count < PartitionNode::kWordsPerEvent)
+    m_buffer_state = nullptr;
+
+  if (!m_buffer_state) {
+    m_buffer_state = m_partition.queue_buffer_state();
+    m_partition.getClient().dispatch();
+  }
+
+  PartitionBufferState state = m_buffer_state();
+
+  // only report the flags when raised, not on every fetch while they stay up
+  if (state.warning && !m_previous_state.warning) {
+    ++m_buffer_warnings;
+    ers::warning(PartitionBufferIssue(ERS_HERE, "WARNING"));
+  }
+  if (state.error && !m_previous_state.error) {
+    ++m_buffer_errors;
+    ers::error(PartitionBufferIssue(ERS_HERE, "ERROR"));
+  }
+  m_previous_state = state;
+
+  size_t n_events = std::min<size_t>(state.word_count / PartitionNode::kWordsPerEvent, m_max_events_per_fetch);
+
+  uhal::ValVector<uint32_t> data; // NOLINT(build/unsigned)
+  if (n_events)
+    data = m_partition.queue_event_read(n_events);
+  // the count for the next fetch comes back in the same packet as the events
+  m_buffer_state = m_partition.queue_buffer_state();
+  try {
+    m_partition.getClient().dispatch();
+  } catch (...) {
+    m_buffer_state = nullptr;
+    throw;
+  }
+  ++m_fetch_count;
+
+  if (!n_events)
+    return 0;
+
+  // fill the other buffer, the events of the current one stay valid until the next fetch
+  m_current ^= 1;
+  m_buffers[m_current].assign(data.begin(), data.end());
+  m_position = 0;
+  m_event_count += n_events;
+
+  if (m_capture_writer)
+    m_capture_writer->append(m_buffers[m_current].data(), n_events);
+
+  TLOG_DEBUG(5) << "Fetched " << n_events << " events, words left in buffer: " << m_buffer_state().word_count;
+  return n_events;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::string
+PartitionEventStream::get_status(bool print_out) const
+{
+  std::vector<std::pair<std::string, std::string>> summary;
+  summary.push_back(std::make_pair("Events read", std::to_string(m_event_count)));
+  summary.push_back(std::make_pair("Fetches", std::to_string(m_fetch_count)));
+  summary.push_back(std::make_pair("Events per fetch (max)", std::to_string(m_max_events_per_fetch)));
+  summary.push_back(std::make_pair("Buffer warnings", std::to_string(m_buffer_warnings)));
+  summary.push_back(std::make_pair("Buffer errors", std::to_string(m_buffer_errors)));
+
+  std::stringstream status;
+  status << format_reg_table(summary, "Partition event stream", { "", "" });
+
+  if (print_out)
+    TLOG() << status.str();
+  return status.str();
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
@@ -23,9 +23,31 @@ namespace timing {
 
 UHAL_REGISTER_DERIVED_NODE(PartitionNode)
 
+const std::vector<std::string> PartitionNode::kRegisterPaths = {
+  "csr.ctrl.part_en",
+  "csr.ctrl.trig_en",
+  "csr.ctrl.buf_en",
+  "csr.ctrl.run_req",
+  "csr.ctrl.trig_ctr_rst",
+  "csr.ctrl.rate_ctrl_en",
+  "csr.ctrl.trig_mask",
+  "csr.ctrl.spill_gate_en",
+  "csr.ctrl.frag_mask",
+  "csr.stat.in_run",
+  "csr.stat.in_spill",
+  "csr.stat.buf_warn",
+  "csr.stat.buf_err",
+  "buf.count",
+  "buf.data",
+  "evtctr",
+  "actrs",
+  "rctrs",
+};
+
 //-----------------------------------------------------------------------------
 PartitionNode::PartitionNode(const uhal::Node& node)
   : TimingNode(node)
+  , m_registers(kRegisterPaths)
 {}
 //-----------------------------------------------------------------------------
 
@@ -37,10 +59,10 @@ PartitionNode::~PartitionNode() {}
 void
 PartitionNode::enable(bool enable, bool dispatch) const
 {
-  getNode("csr.ctrl.part_en").write(enable);
+  m_registers.get(*this, kCtrlPartEn).write(enable);
 
   if (dispatch)
-    getClient().dispatch();
+    dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -58,10 +80,10 @@ PartitionNode::configure(uint32_t trigger_mask, // NOLINT(build/unsigned)
                          bool enable_spill_gate,
                          bool rate_control_enabled) const
 {
-  getNode("csr.ctrl.rate_ctrl_en").write(rate_control_enabled);
-  getNode("csr.ctrl.trig_mask").write(trigger_mask);
-  getNode("csr.ctrl.spill_gate_en").write(enable_spill_gate);
-  getClient().dispatch();
+  m_registers.get(*this, kCtrlRateCtrlEn).write(rate_control_enabled);
+  m_registers.get(*this, kCtrlTrigMask).write(trigger_mask);
+  m_registers.get(*this, kCtrlSpillGateEn).write(enable_spill_gate);
+  dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -69,8 +91,8 @@ PartitionNode::configure(uint32_t trigger_mask, // NOLINT(build/unsigned)
 void
 PartitionNode::configure_rate_ctrl(bool rate_control_enabled) const
 {
-  getNode("csr.ctrl.rate_ctrl_en").write(rate_control_enabled);
-  getClient().dispatch();
+  m_registers.get(*this, kCtrlRateCtrlEn).write(rate_control_enabled);
+  dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -79,8 +101,8 @@ void
 PartitionNode::enable_triggers(bool enable) const
 {
   // Disable the buffer
-  getNode("csr.ctrl.trig_en").write(enable);
-  getClient().dispatch();
+  m_registers.get(*this, kCtrlTrigEn).write(enable);
+  dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -88,7 +110,7 @@ PartitionNode::enable_triggers(bool enable) const
 uint32_t // NOLINT(build/unsigned)
 PartitionNode::read_trigger_mask() const
 {
-  uhal::ValWord<uint32_t> mask = getNode("csr.ctrl.trig_mask").read(); // NOLINT(build/unsigned)
+  uhal::ValWord<uint32_t> mask = m_registers.get(*this, kCtrlTrigMask).read(); // NOLINT(build/unsigned)
   getClient().dispatch();
 
   return mask;
@@ -99,7 +121,7 @@ PartitionNode::read_trigger_mask() const
 uint32_t // NOLINT(build/unsigned)
 PartitionNode::read_buffer_word_count() const
 {
-  uhal::ValWord<uint32_t> words = getNode("buf.count").read(); // NOLINT(build/unsigned)
+  uhal::ValWord<uint32_t> words = m_registers.get(*this, kBufCount).read(); // NOLINT(build/unsigned)
   getClient().dispatch();
 
   return words;
@@ -118,7 +140,7 @@ PartitionNode::num_events_in_buffer() const
 bool
 PartitionNode::read_rob_warning_overflow() const
 {
-  uhal::ValWord<uint32_t> word = getNode("csr.stat.buf_warn").read(); // NOLINT(build/unsigned)
+  uhal::ValWord<uint32_t> word = m_registers.get(*this, kStatBufWarn).read(); // NOLINT(build/unsigned)
   getClient().dispatch();
 
   return word.value();
@@ -129,7 +151,7 @@ PartitionNode::read_rob_warning_overflow() const
 bool
 PartitionNode::read_rob_error() const
 {
-  uhal::ValWord<uint32_t> word = getNode("csr.stat.buf_err").read(); // NOLINT(build/unsigned)
+  uhal::ValWord<uint32_t> word = m_registers.get(*this, kStatBufErr).read(); // NOLINT(build/unsigned)
   getClient().dispatch();
 
   return word.value();
@@ -149,31 +171,54 @@ PartitionNode::read_events(size_t number_of_events) const
     throw EventReadError(ERS_HERE, number_of_events, events_in_buffer);
   }
 
-  uhal::ValVector<uint32_t> raw_events = // NOLINT(build/unsigned)
-    getNode("buf.data").readBlock(events_to_read * kWordsPerEvent);
+  uhal::ValVector<uint32_t> raw_events = queue_event_read(events_to_read); // NOLINT(build/unsigned)
   getClient().dispatch();
 
   return raw_events.value();
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+std::function<PartitionBufferState()>
+PartitionNode::queue_buffer_state() const
+{
+  auto values = read_sub_nodes(m_registers, { kBufCount, kStatBufWarn, kStatBufErr }, false);
+
+  return [values]() {
+    PartitionBufferState state;
+    state.word_count = values.at(kBufCount).value();
+    state.warning = values.at(kStatBufWarn).value();
+    state.error = values.at(kStatBufErr).value();
+    return state;
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+uhal::ValVector<uint32_t> // NOLINT(build/unsigned)
+PartitionNode::queue_event_read(size_t number_of_events) const
+{
+  return m_registers.get(*this, kBufData).readBlock(number_of_events * kWordsPerEvent);
+}
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 void
 PartitionNode::reset() const
 {
   // Disable partition
-  getNode("csr.ctrl.part_en").write(0);
+  m_registers.get(*this, kCtrlPartEn).write(0);
   // disable trigger
-  getNode("csr.ctrl.trig_en").write(0);
+  m_registers.get(*this, kCtrlTrigEn).write(0);
   // Disable buffer in partition 0
-  getNode("csr.ctrl.buf_en").write(0);
+  m_registers.get(*this, kCtrlBufEn).write(0);
   // stop run
-  getNode("csr.ctrl.run_req").write(0);
+  m_registers.get(*this, kCtrlRunReq).write(0);
   // Reset trigger counter
-  getNode("csr.ctrl.trig_ctr_rst").write(1);
+  m_registers.get(*this, kCtrlTrigCtrRst).write(1);
   // Release trigger counter
-  getNode("csr.ctrl.trig_ctr_rst").write(0);
-  getClient().dispatch();
+  m_registers.get(*this, kCtrlTrigCtrRst).write(0);
+  dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -181,24 +226,28 @@ PartitionNode::reset() const
 void
 PartitionNode::start(uint32_t timeout /*milliseconds*/) const // NOLINT(build/unsigned)
 {
+  // the control writes go out in the packet of the first run status poll
+  DeferredDispatchScope deferred_dispatch(*this);
 
   // Disable triggers (just in case)
-  getNode("csr.ctrl.trig_en").write(0);
+  m_registers.get(*this, kCtrlTrigEn).write(0);
   // Disable the buffer
-  getNode("csr.ctrl.buf_en").write(0);
-  getClient().dispatch();
+  m_registers.get(*this, kCtrlBufEn).write(0);
+  dispatch_writes();
   // Re-enable the buffer (flushes it)
-  getNode("csr.ctrl.buf_en").write(1);
-  getClient().dispatch();
+  m_registers.get(*this, kCtrlBufEn).write(1);
+  dispatch_writes();
 
   // Set the run bit and wait for it to be acknowledged
-  getNode("csr.ctrl.run_req").write(1);
-  getClient().dispatch();
+  m_registers.get(*this, kCtrlRunReq).write(1);
+  dispatch_writes();
 
   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
+  const uhal::Node& in_run_node = m_registers.get(*this, kStatInRun);
+
   while (true) {
-    auto in_run = getNode("csr.stat.in_run").read();
+    auto in_run = in_run_node.read();
     getClient().dispatch();
 
     if (in_run)
@@ -210,6 +259,8 @@ PartitionNode::start(uint32_t timeout /*milliseconds*/) const // NOLINT(build/un
     }
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
   }
+
+  deferred_dispatch.flush();
 }
 //-----------------------------------------------------------------------------
 
@@ -217,14 +268,19 @@ PartitionNode::start(uint32_t timeout /*milliseconds*/) const // NOLINT(build/un
 void
 PartitionNode::stop(uint32_t timeout /*milliseconds*/) const // NOLINT(build/unsigned)
 {
-  getNode("csr.ctrl.run_req").write(0);
-  getClient().dispatch();
+  // the run request goes out in the packet of the first run status poll
+  DeferredDispatchScope deferred_dispatch(*this);
+
+  m_registers.get(*this, kCtrlRunReq).write(0);
+  dispatch_writes();
 
   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
+  const uhal::Node& in_run_node = m_registers.get(*this, kStatInRun);
+
   while (true) {
 
-    auto in_run = getNode("csr.stat.in_run").read();
+    auto in_run = in_run_node.read();
     getClient().dispatch();
 
     if (!in_run)
@@ -237,6 +293,8 @@ PartitionNode::stop(uint32_t timeout /*milliseconds*/) const // NOLINT(build/uns
 
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
   }
+
+  deferred_dispatch.flush();
 }
 //-----------------------------------------------------------------------------
 
@@ -245,8 +303,8 @@ PartitionCounts
 PartitionNode::read_command_counts() const
 {
 
-  const uhal::Node& accepted_counters = getNode("actrs");
-  const uhal::Node& rejected_counters = getNode("rctrs");
+  const uhal::Node& accepted_counters = m_registers.get(*this, kAcceptedCounters);
+  const uhal::Node& rejected_counters = m_registers.get(*this, kRejectedCounters);
 
   uhal::ValVector<uint32_t> accepted = accepted_counters.readBlock(accepted_counters.getSize()); // NOLINT(build/unsigned)
   uhal::ValVector<uint32_t> rejected = rejected_counters.readBlock(rejected_counters.getSize()); // NOLINT(build/unsigned)
@@ -307,55 +365,75 @@ PartitionNode::get_status(bool print_out) const
 void
 PartitionNode::get_info(timingfirmwareinfo::TimingPartitionMonitorData& mon_data) const
 {
-  auto controls = read_sub_nodes(getNode("csr.ctrl"), false);
-  auto state = read_sub_nodes(getNode("csr.stat"), false);
-
-  auto event_counter = getNode("evtctr").read();
-  auto buffer_count = getNode("buf.count").read();
-
+  auto decoder = queue_monitor_data();
   getClient().dispatch();
-
-  mon_data.enabled = controls.at("part_en").value();
-  mon_data.spill_interface_enabled = controls.at("spill_gate_en").value();
-  mon_data.trig_enabled = controls.at("trig_en").value();
-  mon_data.trig_mask = controls.at("trig_mask").value();
-  mon_data.rate_ctrl_enabled = controls.at("rate_ctrl_en").value();
-  mon_data.frag_mask = controls.at("frag_mask").value();
-  mon_data.buffer_enabled = controls.at("buf_en").value();
-
-  mon_data.in_run = state.at("in_run").value();
-  mon_data.in_spill = state.at("in_spill").value();
-
-  mon_data.buffer_warning = state.at("buf_warn").value();
-  mon_data.buffer_error = state.at("buf_err").value();
-  mon_data.buffer_occupancy = buffer_count.value();
+  decoder(mon_data);
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 void
-PartitionNode::get_info(opmonlib::InfoCollector& ic, int /*level*/) const
+PartitionNode::get_info(opmonlib::InfoCollector& ic, int level) const
+{
+  collect_info(ic, level);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+PartitionNode::queue_info(int /*level*/) const
 {
-  timingfirmwareinfo::TimingPartitionMonitorData mon_data;
-  this->get_info(mon_data);
-  ic.add(mon_data);
+  auto decoder = queue_monitor_data();
 
-  auto accepted_counters = getNode("actrs").readBlock(getNode("actrs").getSize());
-  auto rejected_counters = getNode("rctrs").readBlock(getNode("actrs").getSize());
-  getClient().dispatch();
+  const uhal::Node& accepted_counters_node = m_registers.get(*this, kAcceptedCounters);
+  const uhal::Node& rejected_counters_node = m_registers.get(*this, kRejectedCounters);
+  auto accepted_counters = accepted_counters_node.readBlock(accepted_counters_node.getSize());
+  auto rejected_counters = rejected_counters_node.readBlock(rejected_counters_node.getSize());
 
+  return [decoder, accepted_counters, rejected_counters](opmonlib::InfoCollector& ic) {
+    timingfirmwareinfo::TimingPartitionMonitorData mon_data;
+    decoder(mon_data);
+    ic.add(mon_data);
 
-  for (auto& cmd : PDIFLCmdGeneratorNode::get_command_map()) {
-    timingfirmwareinfo::TimingFLCmdCounter cmd_counter;
-    opmonlib::InfoCollector cmd_counter_ic;
+    for (auto& cmd : PDIFLCmdGeneratorNode::get_command_map()) {
+      timingfirmwareinfo::TimingFLCmdCounter cmd_counter;
+      opmonlib::InfoCollector cmd_counter_ic;
 
-    cmd_counter.accepted = accepted_counters.at(cmd.first);
-    cmd_counter.rejected = rejected_counters.at(cmd.first);
+      cmd_counter.accepted = accepted_counters.at(cmd.first);
+      cmd_counter.rejected = rejected_counters.at(cmd.first);
 
-    cmd_counter_ic.add(cmd_counter);
-    ic.add(cmd.second, cmd_counter_ic);
-  }
+      cmd_counter_ic.add(cmd_counter);
+      ic.add(cmd.second, cmd_counter_ic);
+    }
+  };
+}
+//-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+std::function<void(timingfirmwareinfo::TimingPartitionMonitorData&)>
+PartitionNode::queue_monitor_data() const
+{
+  auto values = read_sub_nodes(m_registers,
+                               { kCtrlPartEn, kCtrlSpillGateEn, kCtrlTrigEn, kCtrlTrigMask, kCtrlRateCtrlEn, kCtrlFragMask,
+                                 kCtrlBufEn, kStatInRun, kStatInSpill, kStatBufWarn, kStatBufErr, kBufCount },
+                               false);
+
+  return [values](timingfirmwareinfo::TimingPartitionMonitorData& mon_data) {
+    mon_data.enabled = values.at(kCtrlPartEn).value();
+    mon_data.spill_interface_enabled = values.at(kCtrlSpillGateEn).value();
+    mon_data.trig_enabled = values.at(kCtrlTrigEn).value();
+    mon_data.trig_mask = values.at(kCtrlTrigMask).value();
+    mon_data.rate_ctrl_enabled = values.at(kCtrlRateCtrlEn).value();
+    mon_data.frag_mask = values.at(kCtrlFragMask).value();
+    mon_data.buffer_enabled = values.at(kCtrlBufEn).value();
+
+    mon_data.in_run = values.at(kStatInRun).value();
+    mon_data.in_spill = values.at(kStatInSpill).value();
+
+    mon_data.buffer_warning = values.at(kStatBufWarn).value();
+    mon_data.buffer_error = values.at(kStatBufErr).value();
+    mon_data.buffer_occupancy = values.at(kBufCount).value();
+  };
 }
 //-----------------------------------------------------------------------------
 
@@ -0,0 +1,459 @@
+/**
+ * @file SI534xConfig.cpp
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/SI534xConfig.hpp"
+
+// PDT headers
+#include "logging/Logging.hpp"
+#include "timing/toolbox.hpp"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+// Compiled cache file layout (host byte order, the cache is not meant to be shared between hosts)
+//   char[8]   magic
+//   uint32_t  format version
+//   uint64_t  hash of the text file content
+//   uint32_t  design ID length, followed by the design ID characters
+//   3 x section (preamble, registers, postamble):
+//     uint32_t  number of runs
+//     per run: uint16_t start address, uint16_t length, length x uint8_t values
+const char SI534xConfig::kCacheMagic[8] = { 'S', 'I', '5', '3', '4', 'x', 'C', 'C' };
+const uint32_t SI534xConfig::kCacheVersion = 1; // NOLINT(build/unsigned)
+const size_t SI534xConfig::kMaxBlockLength = 64;
+
+//-----------------------------------------------------------------------------
+SI534xConfig
+SI534xConfig::load(const std::string& filename)
+{
+  throw_if_not_file(filename);
+
+  std::ifstream config_file(filename, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(config_file)), std::istreambuf_iterator<char>());
+  config_file.close();
+
+  uint64_t hash = hash_content(content); // NOLINT(build/unsigned)
+  std::string cache_path = get_cache_path(filename, hash);
+
+  SI534xConfig config;
+  if (config.read_cache(cache_path, hash)) {
+    TLOG_DEBUG(8) << "Loaded compiled configuration " << cache_path;
+    return config;
+  }
+
+  std::istringstream config_stream(content);
+  config = parse(config_stream);
+  config.write_cache(cache_path, hash);
+
+  return config;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+SI534xConfig
+SI534xConfig::parse(const std::string& filename)
+{
+  throw_if_not_file(filename);
+
+  std::ifstream config_file(filename);
+  return parse(config_file);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+SI534xConfig
+SI534xConfig::parse(std::istream& file)
+{
+  SI534xConfig config;
+
+  // Seek the header line first
+  config.m_design_id = seek_header(file);
+  std::istream::pos_type header_end = file.tellg();
+
+  std::vector<RegisterSetting_t> preamble, registers, postamble;
+
+  try {
+    preamble = read_config_section(file, "preamble");
+    registers = read_config_section(file, "registers");
+    postamble = read_config_section(file, "postamble");
+  } catch (SI534xMissingConfigSectionError&) {
+    file.clear();
+    file.seekg(header_end);
+    preamble.clear();
+    registers = read_config_section(file, "");
+    postamble.clear();
+  }
+
+  TLOG_DEBUG(8) << "Preamble size = " << preamble.size();
+  TLOG_DEBUG(8) << "Registers size = " << registers.size();
+  TLOG_DEBUG(8) << "PostAmble size = " << postamble.size();
+
+  config.m_preamble = make_blocks(preamble);
+  config.m_registers = make_blocks(registers);
+  config.m_postamble = make_blocks(postamble);
+
+  return config;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::vector<SI534xConfig::RegisterBlock>
+SI534xConfig::make_blocks(const std::vector<RegisterSetting_t>& settings, size_t max_length)
+{
+  std::vector<RegisterBlock> blocks;
+
+  for (auto& setting : settings) {
+    uint16_t address = setting.get<0>(); // NOLINT(build/unsigned)
+
+    // Extend the current run if the address follows on the same page
+    if (!blocks.empty()) {
+      RegisterBlock& last = blocks.back();
+      if (last.data.size() < max_length && address == last.address + last.data.size() &&
+          (address >> 8) == (last.address >> 8)) {
+        last.data.push_back(setting.get<1>());
+        continue;
+      }
+    }
+    blocks.push_back({ address, { setting.get<1>() } });
+  }
+
+  return blocks;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::vector<SI534xConfig::RegisterSetting_t>
+SI534xConfig::expand_blocks(const std::vector<RegisterBlock>& blocks)
+{
+  std::vector<RegisterSetting_t> settings;
+  settings.reserve(count_registers(blocks));
+
+  for (auto& block : blocks) {
+    for (size_t i(0); i < block.data.size(); ++i) {
+      settings.push_back(RegisterSetting_t(block.address + i, block.data.at(i)));
+    }
+  }
+  return settings;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+size_t
+SI534xConfig::count_registers(const std::vector<RegisterBlock>& blocks)
+{
+  size_t count(0);
+  for (auto& block : blocks) {
+    count += block.data.size();
+  }
+  return count;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::string
+SI534xConfig::seek_header(std::istream& file)
+{
+
+  // std::string config_line;
+  std::string design_id;
+
+  std::string config_line;
+  uint32_t line_number; // NOLINT(build/unsigned)
+  for (line_number = 1; std::getline(file, config_line); ++line_number) {
+
+    // Gracefully deal with those damn dos-encoded files
+    if (config_line.back() == '\r')
+      config_line.pop_back();
+
+    // Section end found. Break here
+    if (boost::starts_with(config_line, "# Design ID:")) {
+      design_id = config_line.substr(13);
+    }
+
+    // Skip comments
+    if (config_line[0] == '#')
+      continue;
+
+    // Stop if the line is empty
+    if (config_line.length() == 0)
+      continue;
+
+    // OK, header found, stop here
+    if (config_line == "Address,Data")
+      break;
+
+    if (file.eof()) {
+      throw SI534xConfigError(ERS_HERE, "Incomplete file: End of file detected while seeking the header.");
+    }
+  }
+
+  TLOG_DEBUG(8) << "Found desing ID " << design_id;
+
+  return design_id;
+}
+
+//-----------------------------------------------------------------------------
+// Seek Header
+// Seek conf start
+// read data
+// Stop on conf end
+
+std::vector<SI534xConfig::RegisterSetting_t>
+SI534xConfig::read_config_section(std::istream& file, std::string tag)
+{
+
+  // Line buffer
+  // std::string config_line;
+
+  bool section_found(false);
+
+  std::vector<RegisterSetting_t> config;
+  std::string config_line;
+  uint32_t line_number; // NOLINT(build/unsigned)
+  for (line_number = 1; std::getline(file, config_line); ++line_number) {
+
+    // Gracefully deal with those damn dos-encoded files
+    if (config_line.back() == '\r')
+      config_line.pop_back();
+
+    // Is it a comment
+    if (config_line[0] == '#') {
+
+      if (tag.empty())
+        continue;
+
+      if (boost::starts_with(config_line, "# Start configuration " + tag)) {
+        section_found = true;
+      }
+
+      // Section end found. Break here
+      if (boost::starts_with(config_line, "# End configuration " + tag)) {
+        break;
+      }
+
+      continue;
+    }
+
+    // Oops
+    if (file.eof()) {
+      if (tag.empty())
+        return config;
+      else
+        throw SI534xConfigError(ERS_HERE,
+                                "Incomplete file: End of file detected before the end of " + tag + " section.");
+    }
+
+    // Stop if the line is empty
+    if (config_line.length() == 0)
+      continue;
+
+    // If no sec
+    if (!section_found && !tag.empty()) {
+      throw SI534xMissingConfigSectionError(ERS_HERE, tag);
+    }
+
+    uint32_t address, data; // NOLINT(build/unsigned)
+    char dummy;
+
+    std::istringstream line_stream(config_line);
+    line_stream >> std::hex >> address >> dummy >> std::hex >> data;
+
+    std::stringstream debug_stream;
+    debug_stream << std::showbase << std::hex << "Address: " << address << dummy << " Data: " << data;
+    TLOG_DEBUG(8) << debug_stream.str();
+
+    config.push_back(RegisterSetting_t(address, data));
+  }
+
+  return config;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+uint64_t // NOLINT(build/unsigned)
+SI534xConfig::hash_content(const std::string& content)
+{
+  // 64-bit FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ULL; // NOLINT(build/unsigned)
+  for (unsigned char c : content) {
+    hash ^= c;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::string
+SI534xConfig::get_cache_path(const std::string& filename, uint64_t hash) // NOLINT(build/unsigned)
+{
+  namespace fs = boost::filesystem;
+
+  fs::path config_path(filename);
+
+  const char* env_cache_dir = std::getenv("TIMING_CLOCK_CONFIG_CACHE");
+  fs::path cache_dir =
+    (env_cache_dir != nullptr ? fs::path(env_cache_dir) : config_path.parent_path() / ".compiled");
+
+  std::stringstream cache_name;
+  cache_name << config_path.stem().string() << "." << std::hex << std::setw(16) << std::setfill('0') << hash
+             << ".bin";
+
+  return (cache_dir / cache_name.str()).string();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+bool
+SI534xConfig::read_cache(const std::string& path, uint64_t hash) // NOLINT(build/unsigned)
+{
+  // The records are decoded into vectors anyway, a single plain read is all it takes
+  std::ifstream cache_file(path, std::ios::binary);
+  if (!cache_file)
+    return false;
+
+  std::string buffer((std::istreambuf_iterator<char>(cache_file)), std::istreambuf_iterator<char>());
+  if (!cache_file.good() && !cache_file.eof())
+    return false;
+
+  const char* end = buffer.data() + buffer.size();
+  const char* cursor = buffer.data();
+
+  auto take = [&](void* dest, size_t n) {
+    if (static_cast<size_t>(end - cursor) < n)
+      return false;
+    std::memcpy(dest, cursor, n);
+    cursor += n;
+    return true;
+  };
+
+  auto take_blocks = [&](std::vector<RegisterBlock>& blocks) {
+    uint32_t n_blocks; // NOLINT(build/unsigned)
+    if (!take(&n_blocks, sizeof(n_blocks)))
+      return false;
+
+    blocks.clear();
+    blocks.reserve(n_blocks);
+    for (uint32_t i(0); i < n_blocks; ++i) { // NOLINT(build/unsigned)
+      uint16_t address, length;              // NOLINT(build/unsigned)
+      if (!take(&address, sizeof(address)) || !take(&length, sizeof(length)))
+        return false;
+      if (static_cast<size_t>(end - cursor) < length)
+        return false;
+      blocks.push_back({ address, std::vector<uint8_t>(cursor, cursor + length) }); // NOLINT(build/unsigned)
+      cursor += length;
+    }
+    return true;
+  };
+
+  char magic[sizeof(kCacheMagic)];
+  uint32_t version;       // NOLINT(build/unsigned)
+  uint64_t content_hash;  // NOLINT(build/unsigned)
+  uint32_t id_length;     // NOLINT(build/unsigned)
+
+  bool valid = take(magic, sizeof(magic)) && std::memcmp(magic, kCacheMagic, sizeof(magic)) == 0 &&
+               take(&version, sizeof(version)) && version == kCacheVersion &&
+               take(&content_hash, sizeof(content_hash)) && content_hash == hash &&
+               take(&id_length, sizeof(id_length)) && static_cast<size_t>(end - cursor) >= id_length;
+
+  if (valid) {
+    m_design_id.assign(cursor, id_length);
+    cursor += id_length;
+    valid = take_blocks(m_preamble) && take_blocks(m_registers) && take_blocks(m_postamble) && cursor == end;
+  }
+
+  if (!valid) {
+    TLOG_DEBUG(8) << "Ignoring invalid compiled configuration " << path;
+    m_design_id.clear();
+    m_preamble.clear();
+    m_registers.clear();
+    m_postamble.clear();
+  }
+
+  return valid;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+SI534xConfig::write_cache(const std::string& path, uint64_t hash) const // NOLINT(build/unsigned)
+{
+  namespace fs = boost::filesystem;
+
+  std::string buffer(kCacheMagic, sizeof(kCacheMagic));
+
+  auto put = [&buffer](const void* src, size_t n) { buffer.append(static_cast<const char*>(src), n); };
+
+  auto put_blocks = [&put](const std::vector<RegisterBlock>& blocks) {
+    uint32_t n_blocks = blocks.size(); // NOLINT(build/unsigned)
+    put(&n_blocks, sizeof(n_blocks));
+    for (auto& block : blocks) {
+      uint16_t length = block.data.size(); // NOLINT(build/unsigned)
+      put(&block.address, sizeof(block.address));
+      put(&length, sizeof(length));
+      put(block.data.data(), length);
+    }
+  };
+
+  uint32_t id_length = m_design_id.size(); // NOLINT(build/unsigned)
+
+  put(&kCacheVersion, sizeof(kCacheVersion));
+  put(&hash, sizeof(hash));
+  put(&id_length, sizeof(id_length));
+  put(m_design_id.data(), id_length);
+  put_blocks(m_preamble);
+  put_blocks(m_registers);
+  put_blocks(m_postamble);
+
+  // The cache is an optimisation only: failing to write it (e.g. read-only release area) is not an error
+  boost::system::error_code error;
+  fs::create_directories(fs::path(path).parent_path(), error);
+  if (error) {
+    TLOG_DEBUG(8) << "Cannot create compiled configuration directory for " << path << ": " << error.message();
+    return;
+  }
+
+  // Write to a temporary file and rename it, so that concurrent readers never see a partial cache
+  std::string tmp_path = path + ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream cache_file(tmp_path, std::ios::binary | std::ios::trunc);
+    cache_file.write(buffer.data(), buffer.size());
+    if (!cache_file) {
+      TLOG_DEBUG(8) << "Failed to write compiled configuration " << tmp_path;
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    TLOG_DEBUG(8) << "Failed to install compiled configuration " << path;
+    std::remove(tmp_path.c_str());
+    return;
+  }
+
+  TLOG_DEBUG(8) << "Stored compiled configuration " << path;
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
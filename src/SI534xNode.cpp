@@ -12,11 +12,8 @@
 #include "ers/ers.hpp"
 #include "timing/toolbox.hpp"
 
-#include <boost/algorithm/string/predicate.hpp>
-#include <boost/tuple/tuple.hpp>
 
 #include <chrono>
-#include <fstream>
 #include <map>
 #include <sstream>
 #include <string>
@@ -29,9 +26,13 @@ namespace timing {
 // uHAL Node registation
 UHAL_REGISTER_DERIVED_NODE(SI534xNode)
 
+const uint32_t SI534xSlave::kCalibrationPollInterval = 10; // NOLINT(build/unsigned)
+const uint32_t SI534xSlave::kCalibrationMinTime = 50;      // NOLINT(build/unsigned)
+
 //-----------------------------------------------------------------------------
 SI534xSlave::SI534xSlave(const I2CMasterNode* i2c_master, uint8_t address) // NOLINT(build/unsigned)
   : SIChipSlave(i2c_master, address)
+  , m_settle_time(0)
 {}
 //-----------------------------------------------------------------------------
 
@@ -43,239 +44,287 @@ SI534xSlave::~SI534xSlave() {}
 std::string
 SI534xSlave::read_config_id() const
 {
-  std::string id;
-
-  for (size_t i(0); i < 8; ++i) {
-    id += static_cast<char>(read_clock_register(0x26b + i));
-  }
-  return id;
+  auto id = read_clock_registers(0x26b, 8);
+  return std::string(id.begin(), id.end());
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-std::string
-SI534xSlave::seek_header(std::ifstream& file) const
+std::vector<uint8_t> // NOLINT(build/unsigned)
+SI534xSlave::read_status_registers() const
 {
+  return read_clock_registers(0xc, 7);
+}
+//-----------------------------------------------------------------------------
 
-  // std::string config_line;
-  std::string design_id;
+//-----------------------------------------------------------------------------
+void
+SI534xSlave::configure(const std::string& filename,
+                       bool warm_restart,
+                       uint32_t settle_timeout /*milliseconds*/) const // NOLINT(build/unsigned)
+{
 
-  std::string config_line;
-  uint32_t line_number; // NOLINT(build/unsigned)
-  for (line_number = 1; std::getline(file, config_line); ++line_number) {
+  SI534xConfig config = SI534xConfig::load(filename);
 
-    // Gracefully deal with those damn dos-encoded files
-    if (config_line.back() == '\r')
-      config_line.pop_back();
+  m_settle_time = 0;
 
-    // Section end found. Break here
-    if (boost::starts_with(config_line, "# Design ID:")) {
-      design_id = config_line.substr(13);
+  bool configured(false);
+  if (warm_restart) {
+    try {
+      this->upload_config_differential(config, settle_timeout);
+      configured = true;
+    } catch (const timing::I2CException& e) {
+      ers::warning(SI534xDifferentialConfigFailed(ERS_HERE, config.get_design_id(), e));
     }
+  }
 
-    // Skip comments
-    if (config_line[0] == '#')
-      continue;
-
-    // Stop if the line is empty
-    if (config_line.length() == 0)
-      continue;
-
-    // OK, header found, stop here
-    if (config_line == "Address,Data")
-      break;
-
-    if (file.eof()) {
-      throw SI534xConfigError(ERS_HERE, "Incomplete file: End of file detected while seeking the header.");
-    }
+  if (!configured) {
+    this->upload_config_full(config, settle_timeout);
   }
 
-  TLOG_DEBUG(8) << "Found desing ID " << design_id;
+  std::string chip_design_id = this->read_config_id();
 
-  return design_id;
+  if (config.get_design_id() != chip_design_id) {
+    std::ostringstream message;
+    message << "Post-configuration check failed: Loaded design ID " << chip_design_id
+         << " does not match the configurationd design id " << config.get_design_id() << std::endl;
+    throw SI534xConfigError(ERS_HERE, message.str());
+  }
 }
-
 //-----------------------------------------------------------------------------
-// Seek Header
-// Seek conf start
-// read data
-// Stop on conf end
 
-std::vector<SI534xSlave::RegisterSetting_t>
-SI534xSlave::read_config_section(std::ifstream& file, std::string tag) const
+//-----------------------------------------------------------------------------
+void
+SI534xSlave::upload_config_full(const SI534xConfig& config, uint32_t settle_timeout) const // NOLINT(build/unsigned)
 {
+  try {
+    this->write_clock_register(0x1E, 0x2);
+  } catch (timing::I2CException& excp) {
+    // Do nothing.
+  }
 
-  // Line buffer
-  // std::string config_line;
+  // The soft reset brings the page register back to its default
+  this->invalidate_page_cache();
 
-  bool section_found(false);
+  m_settle_time += this->wait_for_calibration(settle_timeout);
 
-  std::vector<RegisterSetting_t> config;
-  std::string config_line;
-  uint32_t line_number; // NOLINT(build/unsigned)
-  for (line_number = 1; std::getline(file, config_line); ++line_number) {
+  this->upload_config(config.get_preamble());
+  m_settle_time += this->wait_for_calibration(settle_timeout);
+  this->upload_config(config.get_registers());
+  this->upload_config(config.get_postamble());
+  m_settle_time += this->wait_for_calibration(settle_timeout, true);
+}
+//-----------------------------------------------------------------------------
 
-    // Gracefully deal with those damn dos-encoded files
-    if (config_line.back() == '\r')
-      config_line.pop_back();
+//-----------------------------------------------------------------------------
+void
+SI534xSlave::upload_config_differential(const SI534xConfig& config, uint32_t settle_timeout) const // NOLINT(build/unsigned)
+{
+  std::string chip_design_id = this->read_config_id();
+  bool locked = this->is_locked();
 
-    // Is it a comment
-    if (config_line[0] == '#') {
+  if (chip_design_id == config.get_design_id() && locked) {
+    TLOG() << "PLL already running design " << chip_design_id << " and locked, skipping configuration upload";
+    return;
+  }
 
-      if (tag.empty())
-        continue;
+  auto changed_registers = this->find_changed_registers(config.get_registers());
 
-      if (boost::starts_with(config_line, "# Start configuration " + tag)) {
-        section_found = true;
-      }
+  TLOG() << "PLL running design " << chip_design_id << (locked ? " (locked)" : " (not locked)") << ", writing "
+         << SI534xConfig::count_registers(changed_registers) << " out of "
+         << SI534xConfig::count_registers(config.get_registers()) << " registers";
 
-      // Section end found. Break here
-      if (boost::starts_with(config_line, "# End configuration " + tag)) {
-        break;
-      }
+  // The preamble and postamble are always applied, the latter triggers the recalibration
+  this->upload_config(config.get_preamble());
+  m_settle_time += this->wait_for_calibration(settle_timeout);
+  this->upload_config(changed_registers);
+  this->upload_config(config.get_postamble());
+  m_settle_time += this->wait_for_calibration(settle_timeout, true);
+}
+//-----------------------------------------------------------------------------
 
-      continue;
+//-----------------------------------------------------------------------------
+uint32_t // NOLINT(build/unsigned)
+SI534xSlave::wait_for_calibration(uint32_t timeout /*milliseconds*/, bool wait_for_lock) const // NOLINT(build/unsigned)
+{
+  // The ClockBuilder files ask for a fixed 300 ms delay, the worst case time for the device
+  // to complete a calibration. Poll SYSINCAL (0xc bit 0), LOL (0xe bit 1) and HOLD (0xe bit 5)
+  // instead and stop as soon as the device is ready.
+  // The calibration may not have started when the first sample is taken, so SYSINCAL clear
+  // is only trusted once it has been seen set or after kCalibrationMinTime.
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  bool calibration_seen(false);
+  bool calibrated(false);
+
+  while (true) {
+    bool in_calibration(true), lol(true), hold(true);
+    try {
+      auto status = this->read_clock_registers(0xc, 3);
+      in_calibration = dec_rng(status.at(0), 0);
+      lol = dec_rng(status.at(2), 1);
+      hold = dec_rng(status.at(2), 5);
+    } catch (const timing::I2CException& e) {
+      // The chip does not answer while coming out of reset
+      TLOG_DEBUG(9) << "PLL not responding yet";
+      this->invalidate_page_cache();
     }
 
-    // Oops
-    if (file.eof()) {
-      if (tag.empty())
-        return config;
-      else
-        throw SI534xConfigError(ERS_HERE,
-                                "Incomplete file: End of file detected before the end of " + tag + " section.");
-    }
+    uint32_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>( // NOLINT(build/unsigned)
+                         std::chrono::steady_clock::now() - start)
+                         .count();
 
-    // Stop if the line is empty
-    if (config_line.length() == 0)
-      continue;
+    calibration_seen = calibration_seen || in_calibration;
 
-    // If no sec
-    if (!section_found && !tag.empty()) {
-      throw SI534xMissingConfigSectionError(ERS_HERE, tag);
+    if (!calibrated && !in_calibration && (calibration_seen || elapsed >= kCalibrationMinTime)) {
+      TLOG_DEBUG(9) << "PLL calibration done after " << elapsed << " ms";
+      calibrated = true;
     }
 
-    uint32_t address, data; // NOLINT(build/unsigned)
-    char dummy;
-
-    std::istringstream line_stream(config_line);
-    line_stream >> std::hex >> address >> dummy >> std::hex >> data;
+    if (calibrated && (!wait_for_lock || !lol)) {
+      TLOG_DEBUG(9) << "PLL ready after " << elapsed << " ms (LOL " << lol << ", HOLD " << hold << ")";
+      return elapsed;
+    }
 
-    std::stringstream debug_stream;
-    debug_stream << std::showbase << std::hex << "Address: " << address << dummy << " Data: " << data;
-    TLOG_DEBUG(8) << debug_stream.str();
+    if (elapsed > timeout) {
+      if (!calibrated) {
+        throw SI534xCalibrationTimeout(ERS_HERE, timeout);
+      }
+      // The inputs may legitimately be missing at configuration time, e.g. on an endpoint
+      // with no upstream signal yet
+      ers::warning(SI534xLockTimeout(ERS_HERE, timeout));
+      return elapsed;
+    }
 
-    config.push_back(RegisterSetting_t(address, data));
+    std::this_thread::sleep_for(std::chrono::milliseconds(kCalibrationPollInterval));
   }
-
-  return config;
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-void
-SI534xSlave::configure(const std::string& filename) const
+uint32_t // NOLINT(build/unsigned)
+SI534xSlave::get_settle_time() const
 {
+  return m_settle_time;
+}
+//-----------------------------------------------------------------------------
 
-  throw_if_not_file(filename);
-
-  std::ifstream config_file(filename);
-  std::string config_line;
-  std::string conf_design_id;
-
-  // Seek the header line first
-  conf_design_id = seek_header(config_file);
-  std::ifstream::pos_type header_end = config_file.tellg();
-
-  // auto preamble = this->read_config_section(config_file, "preamble");
-  // TIMING_LOG(kDebug) << "Preamble size = " << preamble.size();
-  // auto registers = this->read_config_section(config_file, "registers");
-  // TIMING_LOG(kDebug) << "Registers size = " << registers.size();
-  // auto postamble = this->read_config_section(config_file, "postamble");
-  // TIMING_LOG(kDebug) << "PostAmble size = " << postamble.size();
-
-  std::vector<SI534xSlave::RegisterSetting_t> preamble, registers, postamble;
-
-  try {
-    preamble = this->read_config_section(config_file, "preamble");
-    registers = this->read_config_section(config_file, "registers");
-    postamble = this->read_config_section(config_file, "postamble");
-  } catch (SI534xMissingConfigSectionError&) {
-    config_file.seekg(header_end);
-    preamble.clear();
-    registers = this->read_config_section(config_file, "");
-    postamble.clear();
-  }
-
-  TLOG_DEBUG(8) << "Preamble size = " << preamble.size();
-  TLOG_DEBUG(8) << "Registers size = " << registers.size();
-  TLOG_DEBUG(8) << "PostAmble size = " << postamble.size();
-
-  config_file.close();
-
-  try {
-    this->write_clock_register(0x1E, 0x2);
-  } catch (timing::I2CException& excp) {
-    // Do nothing.
-  }
+//-----------------------------------------------------------------------------
+bool
+SI534xSlave::is_locked() const
+{
+  // SYSINCAL (0xc bit 0), LOSXAXB (0xc bit 1), LOL (0xe bit 1)
+  auto status = this->read_status_registers();
 
-  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  return !dec_rng(status.at(0), 0) && !dec_rng(status.at(0), 1) && !dec_rng(status.at(2), 1);
+}
+//-----------------------------------------------------------------------------
 
-  this->upload_config(preamble);
-  std::this_thread::sleep_for(std::chrono::milliseconds(300));
-  this->upload_config(registers);
-  this->upload_config(postamble);
+//-----------------------------------------------------------------------------
+std::vector<SI534xConfig::RegisterBlock>
+SI534xSlave::find_changed_registers(const std::vector<SI534xConfig::RegisterBlock>& config) const
+{
+  std::vector<RegisterSetting_t> changed;
 
-  std::string chip_design_id = this->read_config_id();
+  for (auto& block : config) {
+    auto chip_data = this->read_clock_registers(block.address, block.data.size());
 
-  if (conf_design_id != chip_design_id) {
-    std::ostringstream message;
-    message << "Post-configuration check failed: Loaded design ID " << chip_design_id
-         << " does not match the configurationd design id " << conf_design_id << std::endl;
-    throw SI534xConfigError(ERS_HERE, message.str());
+    for (size_t i(0); i < block.data.size(); ++i) {
+      if (chip_data.at(i) != block.data.at(i)) {
+        changed.push_back(RegisterSetting_t(block.address + i, block.data.at(i)));
+      }
+    }
   }
+  return SI534xConfig::make_blocks(changed);
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 void
-SI534xSlave::upload_config(const std::vector<SI534xSlave::RegisterSetting_t>& config) const
+SI534xSlave::upload_config(const std::vector<SI534xConfig::RegisterBlock>& config) const
 {
 
-  size_t k(0), notify_percent(10);
-  size_t notify_every = (notify_percent < config.size() ? config.size() / notify_percent : 1);
+  size_t k(0), notify_percent(10), n_registers(SI534xConfig::count_registers(config));
+  size_t notify_every = (notify_percent < n_registers ? n_registers / notify_percent : 1);
+
+  for (auto& block : config) {
 
-  for (const auto& setting : config) {
     std::stringstream debug_stream;
-    debug_stream << std::showbase << std::hex << "Writing to " << (uint32_t)setting.get<0>() // NOLINT(build/unsigned)
-                 << " data " << (uint32_t)setting.get<1>();                                  // NOLINT(build/unsigned)
+    debug_stream << std::showbase << std::hex << "Writing to " << (uint32_t)block.address // NOLINT(build/unsigned)
+                 << std::dec << " " << block.data.size() << " registers";
     TLOG_DEBUG(9) << debug_stream.str();
 
-    uint32_t max_attempts(2), attempt(0); // NOLINT(build/unsigned)
-    while (attempt < max_attempts) {
-      TLOG_DEBUG(9) << "Attempt " << attempt;
-      if (attempt > 0) {
-        ers::warning(SI534xRegWriteRetry(ERS_HERE,
-                                         format_reg_value(attempt, 10),
-                                         format_reg_value((uint32_t)setting.get<0>()))); // NOLINT(build/unsigned)
+    bool block_written(false);
+    if (block.data.size() > 1) {
+      uint32_t max_attempts(2), attempt(0); // NOLINT(build/unsigned)
+      while (attempt < max_attempts) {
+        TLOG_DEBUG(9) << "Attempt " << attempt;
+        if (attempt > 0) {
+          ers::warning(SI534xRegWriteRetry(ERS_HERE,
+                                           format_reg_value(attempt, 10),
+                                           format_reg_value((uint32_t)block.address))); // NOLINT(build/unsigned)
+        }
+        try {
+          this->write_clock_registers(block.address, block.data);
+        } catch (const std::exception& e) {
+          TLOG_DEBUG(9) << "Burst write to " << format_reg_value((uint32_t)block.address) // NOLINT(build/unsigned)
+                        << " failed: " << e.what();
+          ++attempt;
+          continue;
+        }
+        block_written = true;
+        break;
+      }
+
+      if (!block_written) {
+        ers::warning(
+          SI534xBurstWriteFailed(ERS_HERE, format_reg_value((uint32_t)block.address), block.data.size())); // NOLINT(build/unsigned)
       }
-      try {
-        this->write_clock_register(setting.get<0>(), setting.get<1>());
-      } catch (const std::exception& e) {
-        ers::error(SI534xRegWriteFailed(ERS_HERE,
-                                        format_reg_value((uint32_t)setting.get<0>()), // NOLINT(build/unsigned)
-                                        format_reg_value((uint32_t)setting.get<1>()), // NOLINT(build/unsigned)
-                                        e));
-        ++attempt;
-        continue;
+    }
+
+    // Single registers, or fall back to register-by-register writes
+    if (!block_written) {
+      for (size_t i(0); i < block.data.size(); ++i) {
+        this->upload_setting(RegisterSetting_t(block.address + i, block.data.at(i)));
       }
-      break;
     }
 
-    ++k;
-    if ((k % notify_every) == 0) {
-      TLOG_DEBUG(9) << (k / notify_every) * notify_percent << "%";
+    for (size_t i(0); i < block.data.size(); ++i) {
+      ++k;
+      if ((k % notify_every) == 0) {
+        TLOG_DEBUG(9) << (k / notify_every) * notify_percent << "%";
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void
+SI534xSlave::upload_setting(const RegisterSetting_t& setting) const
+{
+  std::stringstream debug_stream;
+  debug_stream << std::showbase << std::hex << "Writing to " << (uint32_t)setting.get<0>() // NOLINT(build/unsigned)
+               << " data " << (uint32_t)setting.get<1>();                                  // NOLINT(build/unsigned)
+  TLOG_DEBUG(9) << debug_stream.str();
+
+  uint32_t max_attempts(2), attempt(0); // NOLINT(build/unsigned)
+  while (attempt < max_attempts) {
+    TLOG_DEBUG(9) << "Attempt " << attempt;
+    if (attempt > 0) {
+      ers::warning(SI534xRegWriteRetry(ERS_HERE,
+                                       format_reg_value(attempt, 10),
+                                       format_reg_value((uint32_t)setting.get<0>()))); // NOLINT(build/unsigned)
+    }
+    try {
+      this->write_clock_register(setting.get<0>(), setting.get<1>());
+    } catch (const std::exception& e) {
+      ers::error(SI534xRegWriteFailed(ERS_HERE,
+                                      format_reg_value((uint32_t)setting.get<0>()), // NOLINT(build/unsigned)
+                                      format_reg_value((uint32_t)setting.get<1>()), // NOLINT(build/unsigned)
+                                      e));
+      ++attempt;
+      continue;
     }
+    break;
   }
 }
 //-----------------------------------------------------------------------------
@@ -287,6 +336,8 @@ SI534xSlave::registers() const
   //  boost::format fmthex("%d");
   std::map<uint16_t, uint8_t> values; // NOLINT(build/unsigned)
 
+  auto status = this->read_status_registers();
+
   for (uint8_t reg_addr = 0xc; reg_addr <= 0x12; reg_addr++) { // NOLINT(build/unsigned)
     if (reg_addr > 0xf && reg_addr < 0x11) {
       continue;
@@ -320,7 +371,7 @@ SI534xSlave::registers() const
     //         continue;
     //     }
 
-    values[reg_addr] = read_clock_register(reg_addr);
+    values[reg_addr] = status.at(reg_addr - 0xc);
   }
 
   return values;
@@ -338,12 +389,14 @@ SI534xSlave::get_info(timinghardwareinfo::TimingPLLMonitorData& mon_data) const
   // lPLLVersion["Device grade"] = pll->read_clock_register(0x4);
   // lPLLVersion["Device revision"] = pll->read_clock_register(0x5);
 
-  uint8_t pll_reg_c = this->read_clock_register(0xc);   // NOLINT(build/unsigned)
-  uint8_t pll_reg_d = this->read_clock_register(0xd);   // NOLINT(build/unsigned)
-  uint8_t pll_reg_e = this->read_clock_register(0xe);   // NOLINT(build/unsigned)
-  uint8_t pll_reg_f = this->read_clock_register(0xf);   // NOLINT(build/unsigned)
-  uint8_t pll_reg_11 = this->read_clock_register(0x11); // NOLINT(build/unsigned)
-  uint8_t pll_reg_12 = this->read_clock_register(0x12); // NOLINT(build/unsigned)
+  auto status = this->read_status_registers();
+
+  uint8_t pll_reg_c = status.at(0x0);  // NOLINT(build/unsigned)
+  uint8_t pll_reg_d = status.at(0x1);  // NOLINT(build/unsigned)
+  uint8_t pll_reg_e = status.at(0x2);  // NOLINT(build/unsigned)
+  uint8_t pll_reg_f = status.at(0x3);  // NOLINT(build/unsigned)
+  uint8_t pll_reg_11 = status.at(0x5); // NOLINT(build/unsigned)
+  uint8_t pll_reg_12 = status.at(0x6); // NOLINT(build/unsigned)
 
   mon_data.cal_pll = dec_rng(pll_reg_f, 5);
   mon_data.hold = dec_rng(pll_reg_e, 5);
@@ -16,6 +16,7 @@
 
 #include <fstream>
 #include <sstream>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
@@ -23,6 +24,7 @@ namespace timing {
 //-----------------------------------------------------------------------------
 SIChipSlave::SIChipSlave(const I2CMasterNode* i2c_master, uint8_t address) // NOLINT(build/unsigned)
   : I2CSlave(i2c_master, address)
+  , m_active_page(kUnknownPage)
 {}
 //-----------------------------------------------------------------------------
 
@@ -38,7 +40,9 @@ SIChipSlave::read_page() const
   TLOG_DEBUG(7) << "<- Reading page ";
 
   // Read from the page address (0x1?)
-  return read_i2c(0x1);
+  uint8_t page = read_i2c(0x1); // NOLINT(build/unsigned)
+  m_active_page = page;
+  return page;
 }
 //-----------------------------------------------------------------------------
 
@@ -50,7 +54,34 @@ SIChipSlave::switch_page(uint8_t page) const // NOLINT(build/unsigned)
   // Prepare a data block with address and new page
   // std::vector<uint8_t> lData = {0x1, page};// NOLINT(build/unsigned)
   TLOG_DEBUG(7) << "-> Switching to page " << format_reg_value((uint32_t)page); // NOLINT(build/unsigned)
+  // The outcome of a failed write is unknown
+  m_active_page = kUnknownPage;
   write_i2c(0x1, page);
+  m_active_page = page;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+SIChipSlave::invalidate_page_cache() const
+{
+  m_active_page = kUnknownPage;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+SIChipSlave::select_page(uint8_t page) const // NOLINT(build/unsigned)
+{
+  // Change page only when required.
+  // (The SI5344 don't like to have the page register id to be written all the time.)
+  if (m_active_page == kUnknownPage) {
+    read_page();
+  }
+
+  if (m_active_page != page) {
+    switch_page(page);
+  }
 }
 //-----------------------------------------------------------------------------
 
@@ -60,7 +91,7 @@ SIChipSlave::read_device_version() const
 {
 
   // Go to the right page
-  switch_page(0x0);
+  select_page(0x0);
   // Read 2 words from 0x2
   auto version = read_i2cArray(0x2, 2);
 
@@ -80,15 +111,18 @@ SIChipSlave::read_clock_register(uint16_t address) const // NOLINT(build/unsigne
                << " reg: " << (uint32_t)reg_address                                    // NOLINT(build/unsigned)
                << " page: " << (uint32_t)page_address;                                 // NOLINT(build/unsigned)
   TLOG_DEBUG(6) << debug_stream.str();
-  // Change page only when required.
-  // (The SI5344 don't like to have the page register id to be written all the time.)
-  uint8_t current_address = read_page(); // NOLINT(build/unsigned)
-  if (page_address != current_address) {
-    switch_page(page_address);
-  }
 
-  // Read the register
-  return read_i2c(reg_address);
+  try {
+    select_page(page_address);
+    return read_i2c(reg_address);
+  } catch (const I2CException& e) {
+    // The cached page may be stale (e.g. the chip was reset behind our back).
+    // Verify the page on the chip and try once more.
+    TLOG_DEBUG(6) << "Register read failed, verifying page";
+    invalidate_page_cache();
+    select_page(page_address);
+    return read_i2c(reg_address);
+  }
 }
 //-----------------------------------------------------------------------------
 
@@ -105,14 +139,80 @@ SIChipSlave::write_clock_register(uint16_t address, uint8_t data) const // NOLIN
                << " reg: " << (uint32_t)reg_address                                     // NOLINT(build/unsigned)
                << " page: " << (uint32_t)page_address;                                  // NOLINT(build/unsigned)
   TLOG_DEBUG(6) << debug_stream.str();
-  // Change page only when required.
-  // (The SI5344 don't like to have the page register id to be written all the time.)
-  uint8_t current_address = read_page(); // NOLINT(build/unsigned)
-  if (page_address != current_address) {
-    switch_page(page_address);
+
+  try {
+    select_page(page_address);
+    write_i2c(reg_address, data);
+  } catch (const I2CException& e) {
+    // The cached page may be stale (e.g. the chip was reset behind our back).
+    // Verify the page on the chip and try once more.
+    TLOG_DEBUG(6) << "Register write failed, verifying page";
+    invalidate_page_cache();
+    select_page(page_address);
+    write_i2c(reg_address, data);
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::vector<uint8_t>                                                                  // NOLINT(build/unsigned)
+SIChipSlave::read_clock_registers(uint16_t address, uint32_t number_of_words) const // NOLINT(build/unsigned)
+{
+
+  uint8_t reg_address = (address & 0xff);       // NOLINT(build/unsigned)
+  uint8_t page_address = (address >> 8) & 0xff; // NOLINT(build/unsigned)
+
+  if (reg_address + number_of_words > 0x100) {
+    throw SIChipPageBoundaryCrossed(ERS_HERE, format_reg_value((uint32_t)address), number_of_words); // NOLINT(build/unsigned)
   }
 
-  return write_i2c(reg_address, data);
+  std::stringstream debug_stream;
+  debug_stream << std::showbase << std::hex << "Read Address " << (uint32_t)address // NOLINT(build/unsigned)
+               << " reg: " << (uint32_t)reg_address                                    // NOLINT(build/unsigned)
+               << " page: " << (uint32_t)page_address                                  // NOLINT(build/unsigned)
+               << std::dec << " size: " << number_of_words;
+  TLOG_DEBUG(6) << debug_stream.str();
+
+  try {
+    select_page(page_address);
+    return read_i2cArray(reg_address, number_of_words);
+  } catch (const I2CException& e) {
+    TLOG_DEBUG(6) << "Register block read failed, verifying page";
+    invalidate_page_cache();
+    select_page(page_address);
+    return read_i2cArray(reg_address, number_of_words);
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+SIChipSlave::write_clock_registers(uint16_t address, const std::vector<uint8_t>& data) const // NOLINT(build/unsigned)
+{
+
+  uint8_t reg_address = (address & 0xff);       // NOLINT(build/unsigned)
+  uint8_t page_address = (address >> 8) & 0xff; // NOLINT(build/unsigned)
+
+  if (reg_address + data.size() > 0x100) {
+    throw SIChipPageBoundaryCrossed(ERS_HERE, format_reg_value((uint32_t)address), data.size()); // NOLINT(build/unsigned)
+  }
+
+  std::stringstream debug_stream;
+  debug_stream << std::showbase << std::hex << "Write Address " << (uint32_t)address // NOLINT(build/unsigned)
+               << " reg: " << (uint32_t)reg_address                                     // NOLINT(build/unsigned)
+               << " page: " << (uint32_t)page_address                                   // NOLINT(build/unsigned)
+               << std::dec << " size: " << data.size();
+  TLOG_DEBUG(6) << debug_stream.str();
+
+  try {
+    select_page(page_address);
+    write_i2cArray(reg_address, data);
+  } catch (const I2CException& e) {
+    TLOG_DEBUG(6) << "Register block write failed, verifying page";
+    invalidate_page_cache();
+    select_page(page_address);
+    write_i2cArray(reg_address, data);
+  }
 }
 //-----------------------------------------------------------------------------
 
@@ -113,7 +113,7 @@ SIMIONode::get_hardware_info(bool print_out) const
 
 //-----------------------------------------------------------------------------
 void
-SIMIONode::reset(const std::string& /*clock_config_file*/) const
+SIMIONode::reset(const std::string& /*clock_config_file*/, bool /*warm_restart*/) const
 {
 
   write_soft_reset_register();
@@ -124,15 +124,16 @@ SIMIONode::reset(const std::string& /*clock_config_file*/) const
 //-----------------------------------------------------------------------------
 void
 SIMIONode::reset(int32_t /*fanout_mode*/, // NOLINT(build/unsigned)
-                     const std::string& clock_config_file) const
+                     const std::string& clock_config_file,
+                     bool warm_restart) const
 {
-  reset(clock_config_file);
+  reset(clock_config_file, warm_restart);
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 void
-SIMIONode::configure_pll(const std::string& /*clock_config_file*/) const
+SIMIONode::configure_pll(const std::string& /*clock_config_file*/, bool /*warm_restart*/) const
 {
   TLOG_DEBUG(0) << "Simulation does not support PLL config";
 }
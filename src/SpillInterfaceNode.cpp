@@ -48,7 +48,7 @@ SpillInterfaceNode::enable() const
 {
   getNode("csr.ctrl.src").write(0);
   getNode("csr.ctrl.en").write(1);
-  getClient().dispatch();
+  dispatch_writes();
   TLOG() << "Spill interface enabled";
 }
 //-----------------------------------------------------------------------------
@@ -58,7 +58,7 @@ void
 SpillInterfaceNode::disable() const
 {
   getNode("csr.ctrl.en").write(0);
-  getClient().dispatch();
+  dispatch_writes();
   TLOG() << "Spill interface disabled";
 }
 //-----------------------------------------------------------------------------
@@ -78,7 +78,7 @@ SpillInterfaceNode::enable_fake_spills(uint32_t cycle_length, uint32_t spill_len
   getNode("csr.ctrl.fake_spill_len").write(spill_length);
   getNode("csr.ctrl.src").write(1);
   getNode("csr.ctrl.en").write(1);
-  getClient().dispatch();
+  dispatch_writes();
   TLOG() << "Fake spills enabled";
 }
 //-----------------------------------------------------------------------------
@@ -97,22 +97,45 @@ SpillInterfaceNode::read_in_spill() const
 void
 SpillInterfaceNode::get_info(timingfirmwareinfo::PDISpillInterfaceMonitorData& mon_data) const
 {
-  auto ctrl_nodes = read_sub_nodes(getNode("csr.ctrl"));
-  auto stat_nodes = read_sub_nodes(getNode("csr.stat"));
-
-  mon_data.spill_interface_enabled = ctrl_nodes["en"];
-  mon_data.source = ctrl_nodes["src"];
-  mon_data.in_spill = stat_nodes["in_spill"];
+  auto decoder = queue_monitor_data();
+  getClient().dispatch();
+  decoder(mon_data);
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 void
-SpillInterfaceNode::get_info(opmonlib::InfoCollector& ic, int /*level*/) const
+SpillInterfaceNode::get_info(opmonlib::InfoCollector& ic, int level) const
+{
+  collect_info(ic, level);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+SpillInterfaceNode::queue_info(int /*level*/) const
+{
+  auto decoder = queue_monitor_data();
+  return [decoder](opmonlib::InfoCollector& ic) {
+    timingfirmwareinfo::PDISpillInterfaceMonitorData mon_data;
+    decoder(mon_data);
+    ic.add(mon_data);
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::function<void(timingfirmwareinfo::PDISpillInterfaceMonitorData&)>
+SpillInterfaceNode::queue_monitor_data() const
 {
-  timingfirmwareinfo::PDISpillInterfaceMonitorData mon_data;
-  this->get_info(mon_data);
-  ic.add(mon_data);
+  auto ctrl_nodes = read_sub_nodes(getNode("csr.ctrl"), false);
+  auto stat_nodes = read_sub_nodes(getNode("csr.stat"), false);
+
+  return [ctrl_nodes, stat_nodes](timingfirmwareinfo::PDISpillInterfaceMonitorData& mon_data) {
+    mon_data.spill_interface_enabled = ctrl_nodes.at("en").value();
+    mon_data.source = ctrl_nodes.at("src").value();
+    mon_data.in_spill = stat_nodes.at("in_spill").value();
+  };
 }
 //-----------------------------------------------------------------------------
 
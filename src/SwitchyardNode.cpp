@@ -48,7 +48,7 @@ SwitchyardNode::configure_master_source(uint8_t master_source, bool dispatch) co
 {
   getNode("csr.ctrl.master_src").write(master_source);
   if (dispatch)
-    getClient().dispatch();
+    dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -58,7 +58,7 @@ SwitchyardNode::configure_endpoint_source(uint8_t endpoint_source, bool dispatch
 {
   getNode("csr.ctrl.ep_src").write(endpoint_source);
   if (dispatch)
-    getClient().dispatch();
+    dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -23,7 +23,10 @@ TLUIONode::TLUIONode(const uhal::Node& node)
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-TLUIONode::~TLUIONode() {}
+TLUIONode::~TLUIONode()
+{
+  stop_i2c_info_sampler();
+}
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
@@ -50,22 +53,27 @@ TLUIONode::get_status(bool print_out) const
 
 //-----------------------------------------------------------------------------
 void
-TLUIONode::reset(const std::string& clock_config_file) const
+TLUIONode::reset(const std::string& clock_config_file, bool warm_restart) const
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   // Soft reset
   write_soft_reset_register();
 
   millisleep(1000);
 
-  // Reset PLL and I2C
-  getNode("csr.ctrl.pll_rst").write(0x1);
-  getNode("csr.ctrl.pll_rst").write(0x0);
+  // Reset PLL, unless it is kept running, and I2C
+  if (!warm_restart) {
+    getNode("csr.ctrl.pll_rst").write(0x1);
+    getNode("csr.ctrl.pll_rst").write(0x0);
+  }
 
   getNode("csr.ctrl.rst_i2c").write(0x1);
   getNode("csr.ctrl.rst_i2c").write(0x0);
 
   getClient().dispatch();
 
+  invalidate_i2c_core_states();
+
   // enclustra i2c switch stuff
   try {
     getNode<I2CMasterNode>(m_uid_i2c_bus).get_slave("AX3_Switch").write_i2c(0x01, 0x7f);
@@ -78,7 +86,7 @@ TLUIONode::reset(const std::string& clock_config_file) const
   TLOG() << "PLL configuration file : " << clock_config_path;
 
   // Upload config file to PLL
-  configure_pll(clock_config_path);
+  configure_pll(clock_config_path, warm_restart);
 
   // Tweak the PLL swing
   auto si_chip = get_pll();
@@ -93,25 +101,9 @@ TLUIONode::reset(const std::string& clock_config_file) const
   auto ic_6 = get_i2c_device<I2CExpanderSlave>(m_uid_i2c_bus, "Expander1");
   auto ic_7 = get_i2c_device<I2CExpanderSlave>(m_uid_i2c_bus, "Expander2");
 
-  // Bank 0
-  ic_6->set_inversion(0, 0x00);
-  ic_6->set_io(0, 0x00);
-  ic_6->set_outputs(0, 0x00);
-
-  // Bank 1
-  ic_6->set_inversion(1, 0x00);
-  ic_6->set_io(1, 0x00);
-  ic_6->set_outputs(1, 0x88);
-
-  // Bank 0
-  ic_7->set_inversion(0, 0x00);
-  ic_7->set_io(0, 0x00);
-  ic_7->set_outputs(0, 0xf0);
-
-  // Bank 1
-  ic_7->set_inversion(1, 0x00);
-  ic_7->set_io(1, 0x00);
-  ic_7->set_outputs(1, 0xf0);
+  // All outputs
+  ic_6->configure({ 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x88 });
+  ic_7->configure({ 0x00, 0x00, 0xf0 }, { 0x00, 0x00, 0xf0 });
 
   // BI signals are NIM
   uint32_t bi_signal_threshold = 0x589D; // NOLINT(build/unsigned)
@@ -128,9 +120,10 @@ TLUIONode::reset(const std::string& clock_config_file) const
 //-----------------------------------------------------------------------------
 void
 TLUIONode::reset(int32_t /*fanout_mode*/, // NOLINT(build/unsigned)
-                     const std::string& clock_config_file) const
+                     const std::string& clock_config_file,
+                     bool warm_restart) const
 {
-  reset(clock_config_file);
+  reset(clock_config_file, warm_restart);
 }
 //-----------------------------------------------------------------------------
 
@@ -138,6 +131,7 @@ TLUIONode::reset(int32_t /*fanout_mode*/, // NOLINT(build/unsigned)
 void
 TLUIONode::configure_dac(uint32_t dac_id, uint32_t dac_value, bool internal_ref) const // NOLINT(build/unsigned)
 {
+  std::lock_guard<std::recursive_mutex> i2c_lock(m_i2c_mutex);
   std::string dac_device;
   try {
     dac_device = m_dac_devices.at(dac_id);
@@ -171,17 +165,9 @@ TLUIONode::switch_sfp_soft_tx_control_bit(uint32_t /*sfp_id*/, bool /*turn_on*/)
 void
 TLUIONode::get_info(timinghardwareinfo::TimingTLUMonitorData& mon_data) const
 {
-
-  auto subnodes = read_sub_nodes(getNode("csr.stat"));
-
-  mon_data.cdr_lol = subnodes.at("cdr_lol");
-  mon_data.cdr_los = subnodes.at("cdr_los");
-  mon_data.mmcm_ok = subnodes.at("mmcm_ok");
-  mon_data.mmcm_sticky = subnodes.at("mmcm_sticky");
-  mon_data.pll_ok = subnodes.at("pll_ok");
-  mon_data.pll_sticky = subnodes.at("pll_sticky");
-  mon_data.sfp_flt = subnodes.at("sfp_fault");
-  mon_data.sfp_los = subnodes.at("sfp_los");
+  auto decoder = queue_monitor_data();
+  getClient().dispatch();
+  decoder(mon_data);
 }
 //-----------------------------------------------------------------------------
 
@@ -189,17 +175,54 @@ TLUIONode::get_info(timinghardwareinfo::TimingTLUMonitorData& mon_data) const
 void
 TLUIONode::get_info(opmonlib::InfoCollector& ci, int level) const
 {
+  collect_info(ci, level);
+}
+//-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+TLUIONode::queue_info(int level) const
+{
+  // the I2C data is read at decode time, or taken from the background sampler
+  InfoDecoder i2c_decoder;
   if (level >= 2) {
-    timinghardwareinfo::TimingPLLMonitorData pll_mon_data;
-    this->get_pll()->get_info(pll_mon_data);
-    ci.add(pll_mon_data);
+    i2c_decoder = queue_i2c_info(level);
   }
+
+  std::function<void(timinghardwareinfo::TimingTLUMonitorData&)> decoder;
   if (level >= 1) {
-    timinghardwareinfo::TimingTLUMonitorData mon_data;
-    this->get_info(mon_data);
-    ci.add(mon_data);
+    decoder = queue_monitor_data();
   }
+
+  return [i2c_decoder, decoder](opmonlib::InfoCollector& ci) {
+    if (i2c_decoder) {
+      i2c_decoder(ci);
+    }
+    if (decoder) {
+      timinghardwareinfo::TimingTLUMonitorData mon_data;
+      decoder(mon_data);
+      ci.add(mon_data);
+    }
+  };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::function<void(timinghardwareinfo::TimingTLUMonitorData&)>
+TLUIONode::queue_monitor_data() const
+{
+  auto subnodes = read_sub_nodes(getNode("csr.stat"), false);
+
+  return [=](timinghardwareinfo::TimingTLUMonitorData& mon_data) {
+    mon_data.cdr_lol = subnodes.at("cdr_lol").value();
+    mon_data.cdr_los = subnodes.at("cdr_los").value();
+    mon_data.mmcm_ok = subnodes.at("mmcm_ok").value();
+    mon_data.mmcm_sticky = subnodes.at("mmcm_sticky").value();
+    mon_data.pll_ok = subnodes.at("pll_ok").value();
+    mon_data.pll_sticky = subnodes.at("pll_sticky").value();
+    mon_data.sfp_flt = subnodes.at("sfp_fault").value();
+    mon_data.sfp_los = subnodes.at("sfp_los").value();
+  };
 }
 //-----------------------------------------------------------------------------
 
@@ -0,0 +1,309 @@
+/**
+ * @file TimestampExtrapolator.cpp
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/TimestampExtrapolator.hpp"
+
+#include "timing/TimingIssues.hpp"
+#include "timing/toolbox.hpp"
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+//-----------------------------------------------------------------------------
+const size_t TimestampExtrapolator::kFitSamples = 16;
+const double TimestampExtrapolator::kDriftPPM = 50.;
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimestampExtrapolator::TimestampExtrapolator(ReadFunction read_timestamp,
+                                             uint32_t clock_frequency_hz, // NOLINT(build/unsigned)
+                                             std::chrono::milliseconds period,
+                                             std::chrono::nanoseconds resync_threshold)
+  : m_read_timestamp(std::move(read_timestamp))
+  , m_clock_frequency_hz(clock_frequency_hz)
+  , m_nominal_ticks_per_ns(clock_frequency_hz / 1e9)
+  , m_period(period)
+  , m_resync_threshold(resync_threshold)
+  , m_stop(true)
+  , m_fit_origin{ 0, 0, 0 }
+  , m_fit_offset(0.)
+  , m_fit_slope(m_nominal_ticks_per_ns)
+  , m_fit_error_ns(0)
+  , m_resync_count(0)
+{}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimestampExtrapolator::~TimestampExtrapolator()
+{
+  stop();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+TimestampExtrapolator::start()
+{
+  stop();
+
+  auto sample = take_sample();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  add_sample(sample);
+  m_stop = false;
+  m_thread = std::thread(&TimestampExtrapolator::run, this);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+TimestampExtrapolator::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_stop_condition.notify_all();
+
+  if (m_thread.joinable())
+    m_thread.join();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+bool
+TimestampExtrapolator::is_running() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return !m_stop;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+TimestampExtrapolator::resync()
+{
+  auto sample = take_sample();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_samples.clear();
+  ++m_resync_count;
+  add_sample(sample);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+uint64_t // NOLINT(build/unsigned)
+TimestampExtrapolator::read_timestamp() const
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_samples.empty())
+      return m_fit_origin.timestamp + std::llround(extrapolate(host_time_ns()));
+  }
+  return m_read_timestamp();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+uint64_t // NOLINT(build/unsigned)
+TimestampExtrapolator::read_timestamp_ns() const
+{
+  uint64_t timestamp = read_timestamp(); // NOLINT(build/unsigned)
+
+  // split off the whole seconds so that the product cannot overflow
+  uint64_t seconds = timestamp / m_clock_frequency_hz;   // NOLINT(build/unsigned)
+  uint64_t remainder = timestamp % m_clock_frequency_hz; // NOLINT(build/unsigned)
+  return seconds * 1000000000ULL + remainder * 1000000000ULL / m_clock_frequency_hz;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::chrono::nanoseconds
+TimestampExtrapolator::get_error_bound() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_samples.empty())
+    return std::chrono::nanoseconds(0);
+
+  int64_t age_ns = host_time_ns() - m_samples.back().host_time_ns;
+  return std::chrono::nanoseconds(m_fit_error_ns + std::llround(age_ns * kDriftPPM * 1e-6));
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+double
+TimestampExtrapolator::get_fitted_frequency() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_fit_slope * 1e9;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+uint64_t // NOLINT(build/unsigned)
+TimestampExtrapolator::get_resync_count() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_resync_count;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::string
+TimestampExtrapolator::get_status(bool print_out) const
+{
+  std::vector<std::pair<std::string, std::string>> summary;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    summary.push_back(std::make_pair("Running", std::to_string(!m_stop)));
+    summary.push_back(std::make_pair("Samples", std::to_string(m_samples.size())));
+    summary.push_back(std::make_pair("Resyncs", std::to_string(m_resync_count)));
+    summary.push_back(std::make_pair("Nominal frequency [Hz]", std::to_string(m_nominal_ticks_per_ns * 1e9)));
+    summary.push_back(std::make_pair("Fitted frequency [Hz]", std::to_string(m_fit_slope * 1e9)));
+    summary.push_back(std::make_pair("Fit error [ns]", std::to_string(m_fit_error_ns)));
+  }
+  summary.push_back(std::make_pair("Error bound [ns]", std::to_string(get_error_bound().count())));
+
+  std::stringstream status;
+  status << format_reg_table(summary, "Timestamp extrapolation", { "", "" });
+
+  if (print_out)
+    TLOG() << status.str();
+  return status.str();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+int64_t
+TimestampExtrapolator::host_time_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimestampExtrapolator::Sample
+TimestampExtrapolator::take_sample() const
+{
+  int64_t before = host_time_ns();
+  uint64_t timestamp = m_read_timestamp(); // NOLINT(build/unsigned)
+  int64_t after = host_time_ns();
+
+  return { before + (after - before) / 2, timestamp, (after - before) / 2 };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+TimestampExtrapolator::add_sample(const Sample& sample)
+{
+  if (!m_samples.empty()) {
+    double offset_ns =
+      std::abs(static_cast<int64_t>(sample.timestamp - m_fit_origin.timestamp) - extrapolate(sample.host_time_ns)) /
+      m_fit_slope;
+    int64_t age_ns = sample.host_time_ns - m_samples.back().host_time_ns;
+    double tolerance_ns = m_resync_threshold.count() + m_fit_error_ns + sample.uncertainty_ns + age_ns * kDriftPPM * 1e-6;
+
+    if (offset_ns > tolerance_ns) {
+      TLOG_DEBUG(1) << "Timestamp sample " << format_reg_value(sample.timestamp) << " is " << offset_ns
+                    << " ns off the extrapolation, resyncing";
+      m_samples.clear();
+      ++m_resync_count;
+    }
+  }
+
+  m_samples.push_back(sample);
+  while (m_samples.size() > kFitSamples)
+    m_samples.pop_front();
+
+  fit();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+TimestampExtrapolator::fit()
+{
+  // least squares line through the samples, relative to the oldest one to keep the double precision
+  m_fit_origin = m_samples.front();
+  m_fit_offset = 0.;
+  m_fit_slope = m_nominal_ticks_per_ns;
+
+  double n = m_samples.size();
+  double sum_x = 0., sum_y = 0., sum_xx = 0., sum_xy = 0.;
+  for (auto& sample : m_samples) {
+    double x = sample.host_time_ns - m_fit_origin.host_time_ns;
+    double y = static_cast<int64_t>(sample.timestamp - m_fit_origin.timestamp);
+    sum_x += x;
+    sum_y += y;
+    sum_xx += x * x;
+    sum_xy += x * y;
+  }
+
+  double denominator = n * sum_xx - sum_x * sum_x;
+  if (m_samples.size() > 1 && denominator > 0.) {
+    m_fit_slope = (n * sum_xy - sum_x * sum_y) / denominator;
+    m_fit_offset = (sum_y - m_fit_slope * sum_x) / n;
+  }
+
+  m_fit_error_ns = 0;
+  for (auto& sample : m_samples) {
+    double residual_ns =
+      std::abs(static_cast<int64_t>(sample.timestamp - m_fit_origin.timestamp) - extrapolate(sample.host_time_ns)) /
+      m_fit_slope;
+    m_fit_error_ns = std::max<int64_t>(m_fit_error_ns, std::llround(residual_ns) + sample.uncertainty_ns);
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+double
+TimestampExtrapolator::extrapolate(int64_t host_time_ns) const
+{
+  return m_fit_offset + m_fit_slope * (host_time_ns - m_fit_origin.host_time_ns);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+TimestampExtrapolator::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stop_condition.wait_for(lock, m_period, [this] { return m_stop; })) {
+    lock.unlock();
+
+    bool sampled = false;
+    Sample sample;
+    try {
+      sample = take_sample();
+      sampled = true;
+    } catch (const std::exception& e) {
+      ers::warning(TimestampSampleFailed(ERS_HERE, e));
+    }
+
+    lock.lock();
+    if (sampled)
+      add_sample(sample);
+  }
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
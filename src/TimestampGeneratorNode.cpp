@@ -8,16 +8,27 @@
 
 #include "timing/TimestampGeneratorNode.hpp"
 
+#include "timing/TimingIssues.hpp"
 #include "timing/toolbox.hpp"
 #include "logging/Logging.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
 
 UHAL_REGISTER_DERIVED_NODE(TimestampGeneratorNode)
 
+//-----------------------------------------------------------------------------
+const std::chrono::milliseconds TimestampGeneratorNode::kSyncReadBackInterval(50);
+const double TimestampGeneratorNode::kMaxSyncFrequencyErrorPPM = 1000.;
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 TimestampGeneratorNode::TimestampGeneratorNode(const uhal::Node& node)
   : TimingNode(node)
@@ -71,5 +82,89 @@ TimestampGeneratorNode::set_timestamp(uint64_t timestamp) const // NOLINT(build/
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+TimestampSyncResult
+TimestampGeneratorNode::sync_timestamp(uint32_t clock_frequency_hz, uint32_t probes) const // NOLINT(build/unsigned)
+{
+  TimestampSyncResult result;
+
+  // the fit below needs two read backs, and the round trip at least one probe
+  probes = std::max<uint32_t>(probes, 2); // NOLINT(build/unsigned)
+
+  // the write lands about half the shortest round trip after the dispatch starts
+  std::chrono::nanoseconds round_trip = std::chrono::nanoseconds::max();
+  for (uint32_t i = 0; i < probes; ++i) { // NOLINT(build/unsigned)
+    auto before = std::chrono::steady_clock::now();
+    read_raw_timestamp();
+    round_trip = std::min<std::chrono::nanoseconds>(round_trip, std::chrono::steady_clock::now() - before);
+  }
+  result.round_trip_ns = round_trip.count();
+
+  auto target = std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::system_clock::duration>(round_trip / 2);
+  set_timestamp(host_time_to_timestamp(target, clock_frequency_hz));
+
+  // fit the offset between the timestamp and the host clock over read backs spread by kSyncReadBackInterval,
+  // each read taken at the middle of its round trip
+  const double ticks_per_ns = clock_frequency_hz / 1e9;
+  std::vector<std::pair<double, double>> offsets;
+  std::chrono::steady_clock::time_point first_read;
+  for (uint32_t i = 0; i < probes; ++i) { // NOLINT(build/unsigned)
+    if (i)
+      std::this_thread::sleep_for(kSyncReadBackInterval);
+
+    auto host_before = std::chrono::system_clock::now();
+    auto before = std::chrono::steady_clock::now();
+    uint64_t timestamp = read_timestamp(); // NOLINT(build/unsigned)
+    auto half_round_trip = (std::chrono::steady_clock::now() - before) / 2;
+    auto middle = before + half_round_trip;
+    auto host_middle = host_before + std::chrono::duration_cast<std::chrono::system_clock::duration>(half_round_trip);
+    if (i == 0)
+      first_read = middle;
+
+    double offset_ns = static_cast<int64_t>(timestamp - host_time_to_timestamp(host_middle, clock_frequency_hz)) / ticks_per_ns;
+    offsets.push_back(std::make_pair(std::chrono::duration<double, std::nano>(middle - first_read).count(), offset_ns));
+  }
+
+  double n = offsets.size();
+  double sum_t = 0., sum_o = 0., sum_tt = 0., sum_to = 0.;
+  for (auto& offset : offsets) {
+    sum_t += offset.first;
+    sum_o += offset.second;
+    sum_tt += offset.first * offset.first;
+    sum_to += offset.first * offset.second;
+  }
+  double denominator = n * sum_tt - sum_t * sum_t;
+  double slope = denominator > 0. ? (n * sum_to - sum_t * sum_o) / denominator : 0.;
+
+  // offset at the first read back, i.e. right after the write
+  result.residual_offset_ns = std::llround((sum_o - slope * sum_t) / n);
+  result.frequency_error_ppm = slope * 1e6;
+
+  // the read back jitter makes the fit good to some ppm only: this catches a stopped counter or a wrong frequency
+  if (std::abs(result.frequency_error_ppm) > kMaxSyncFrequencyErrorPPM)
+    ers::warning(TimestampRateMismatch(ERS_HERE, result.frequency_error_ppm));
+
+  TLOG() << "Timestamp synchronised to host clock, round trip: " << result.round_trip_ns
+         << " ns, residual offset: " << result.residual_offset_ns
+         << " ns, frequency error: " << result.frequency_error_ppm << " ppm";
+  return result;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+uint64_t // NOLINT(build/unsigned)
+TimestampGeneratorNode::host_time_to_timestamp(std::chrono::system_clock::time_point time,
+                                               uint32_t clock_frequency_hz) // NOLINT(build/unsigned)
+{
+  // split seconds and nanoseconds, the product of the full nanoseconds and frequency overflows 64 bits
+  auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch());
+  auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+  uint64_t nanoseconds = (since_epoch - seconds).count(); // NOLINT(build/unsigned)
+
+  return static_cast<uint64_t>(seconds.count()) * clock_frequency_hz + // NOLINT(build/unsigned)
+         nanoseconds * clock_frequency_hz / 1000000000;
+}
+//-----------------------------------------------------------------------------
+
 } // namespace timing
 } // namespace dunedaq
\ No newline at end of file
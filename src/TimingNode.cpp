@@ -8,12 +8,98 @@
 
 #include "timing/TimingNode.hpp"
 
+#include "timing/TimingIssues.hpp"
+
+#include "ers/ers.hpp"
+
+#include <exception>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
 
+//-----------------------------------------------------------------------------
+NodeHandleTable::NodeHandleTable(const std::vector<std::string>& paths)
+  : m_paths(paths)
+  , m_handles(new std::atomic<const uhal::Node*>[paths.size()])
+{
+  for (size_t i = 0; i < m_paths.size(); ++i)
+    m_handles[i].store(nullptr);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+NodeHandleTable::NodeHandleTable(const NodeHandleTable& other)
+  : NodeHandleTable(other.m_paths)
+{}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+const uhal::Node&
+NodeHandleTable::get(const uhal::Node& parent, size_t id) const
+{
+  const uhal::Node* handle = m_handles[id].load(std::memory_order_acquire);
+  if (handle == nullptr) {
+    // concurrent first uses resolve to the same node, so the race is harmless
+    handle = &parent.getNode(m_paths.at(id));
+    m_handles[id].store(handle, std::memory_order_release);
+  }
+  return *handle;
+}
+//-----------------------------------------------------------------------------
+
+thread_local std::map<const uhal::ClientInterface*, uint32_t> DeferredDispatchScope::s_depths; // NOLINT(build/unsigned)
+
+//-----------------------------------------------------------------------------
+DeferredDispatchScope::DeferredDispatchScope(const uhal::Node& node)
+  : m_client(node.getClient())
+  , m_uncaught_exceptions(std::uncaught_exceptions())
+{
+  ++s_depths[&m_client];
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+DeferredDispatchScope::~DeferredDispatchScope() noexcept(false)
+{
+  auto it = s_depths.find(&m_client);
+  if (--it->second > 0)
+    return;
+
+  s_depths.erase(it);
+
+  if (std::uncaught_exceptions() == m_uncaught_exceptions) {
+    m_client.dispatch();
+    return;
+  }
+
+  // Flush even when unwinding, so that the writes issued before the failure reach the hardware
+  try {
+    m_client.dispatch();
+  } catch (const std::exception& e) {
+    ers::error(DeferredDispatchFailed(ERS_HERE, e));
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+DeferredDispatchScope::flush() const
+{
+  m_client.dispatch();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+bool
+DeferredDispatchScope::is_active(const uhal::ClientInterface& client)
+{
+  return s_depths.count(&client);
+}
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 TimingNode::TimingNode(const uhal::Node& node)
   : uhal::Node(node)
@@ -40,6 +126,20 @@ TimingNode::read_sub_nodes(const uhal::Node& node, bool dispatch) const
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+std::vector<uhal::ValWord<uint32_t>> // NOLINT(build/unsigned)
+TimingNode::read_sub_nodes(const NodeHandleTable& registers, const std::vector<size_t>& ids, bool dispatch) const
+{
+  std::vector<uhal::ValWord<uint32_t>> values(registers.size()); // NOLINT(build/unsigned)
+
+  for (auto id : ids)
+    values.at(id) = registers.get(*this, id).read();
+  if (dispatch)
+    getClient().dispatch();
+  return values;
+}
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 void
 TimingNode::reset_sub_nodes(const uhal::Node& node, uint32_t aValue, bool dispatch) const // NOLINT(build/unsigned)
@@ -51,6 +151,43 @@ TimingNode::reset_sub_nodes(const uhal::Node& node, uint32_t aValue, bool dispat
     node.getNode(*it).write(aValue);
 
   if (dispatch)
+    dispatch_writes();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+TimingNode::InfoDecoder
+TimingNode::queue_info(int level) const
+{
+  return [this, level](opmonlib::InfoCollector& ci) { this->get_info(ci, level); };
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+TimingNode::collect_info(opmonlib::InfoCollector& ci, int level) const
+{
+  auto decoder = queue_info(level);
+  getClient().dispatch();
+  decoder(ci);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+TimingNode::decode_info(opmonlib::InfoCollector& ci, const std::string& name, const InfoDecoder& decoder)
+{
+  opmonlib::InfoCollector child_ci;
+  decoder(child_ci);
+  ci.add(name, child_ci);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+TimingNode::dispatch_writes() const
+{
+  if (!DeferredDispatchScope::is_active(getClient()))
     getClient().dispatch();
 }
 //-----------------------------------------------------------------------------
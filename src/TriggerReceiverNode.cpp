@@ -65,7 +65,7 @@ void
 TriggerReceiverNode::enable() const
 {
   getNode("csr.ctrl.ep_en").write(0x1);
-  getClient().dispatch();
+  dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -74,7 +74,7 @@ void
 TriggerReceiverNode::disable() const
 {
   getNode("csr.ctrl.ep_en").write(0x0);
-  getClient().dispatch();
+  dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -84,7 +84,7 @@ TriggerReceiverNode::reset() const
 {
   getNode("csr.ctrl.ep_en").write(0x0);
   getNode("csr.ctrl.ep_en").write(0x1);
-  getClient().dispatch();
+  dispatch_writes();
 }
 //-----------------------------------------------------------------------------
 
@@ -93,7 +93,7 @@ void
 TriggerReceiverNode::enable_triggers() const
 {
   getNode("csr.ctrl.ext_trig_en").write(0x1);
-  getClient().dispatch();
+  dispatch_writes();
 }
 //------------------------------------------------------------------------------
 
@@ -102,7 +102,7 @@ void
 TriggerReceiverNode::disable_triggers() const
 {
   getNode("csr.ctrl.ext_trig_en").write(0x0);
-  getClient().dispatch();
+  dispatch_writes();
 }
 //------------------------------------------------------------------------------
 